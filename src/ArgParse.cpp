@@ -54,6 +54,38 @@ cl::opt<std::string> OutputPythonMapDir("o-python-map-dir",
   cl::value_desc("directory"),
   cl::cat(ToolTemplateCategory));
 
+cl::opt<bool> GenerateMappingsDB("mappings-db",
+  cl::desc("Generate binary CUDA to HIP mappings database"),
+  cl::value_desc("mappings-db"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<std::string> OutputMappingsDBDir("o-mappings-db-dir",
+  cl::desc("Output directory for binary CUDA to HIP mappings database"),
+  cl::value_desc("directory"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<unsigned> PrintTopAPIs("print-top-apis",
+  cl::desc("Print the top N CUDA APIs by references and the top N unsupported ones by references and by files, "
+           "counted in bounded memory"),
+  cl::value_desc("N"),
+  cl::init(0),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<bool> EmitUsageIndex("emit-usage-index",
+  cl::desc("Write the index of all the references to CUDA APIs in the hipified files, to be queried by -query-usage"),
+  cl::value_desc("emit-usage-index"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<std::string> OutputUsageIndexFilename("o-usage-index",
+  cl::desc("CUDA API usage index file, written by -emit-usage-index and read by -query-usage (hipify-usage.idx by default)"),
+  cl::value_desc("filename"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<std::string> QueryUsage("query-usage",
+  cl::desc("Print the references to the CUDA name, or to all the CUDA names with the prefix if it ends with '*', from the usage index"),
+  cl::value_desc("CUDA name"),
+  cl::cat(ToolTemplateCategory));
+
 cl::opt<std::string> TemporaryDir("temp-dir",
   cl::desc("Temporary directory"),
   cl::value_desc("directory"),
@@ -104,11 +136,33 @@ cl::opt<bool> PrintStatsCSV("print-stats-csv",
   cl::value_desc("print-stats-csv"),
   cl::cat(ToolTemplateCategory));
 
+cl::opt<bool> PrintMatcherProfile("print-matcher-profile",
+  cl::desc("Print time spent and matches count per AST matcher in translation statistics"),
+  cl::value_desc("print-matcher-profile"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<bool> PrintStartupProfile("print-startup-profile",
+  cl::desc("Print time spent by phases from the start till the first source file is ready to be hipified"),
+  cl::value_desc("print-startup-profile"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<std::string> OutputStartupProfileFilename("o-startup-profile",
+  cl::desc("Output CSV filename to append the startup profile to"),
+  cl::value_desc("filename"),
+  cl::cat(ToolTemplateCategory));
+
 cl::opt<std::string> OutputStatsFilename("o-stats",
   cl::desc("Output filename for statistics"),
   cl::value_desc("filename"),
   cl::cat(ToolTemplateCategory));
 
+cl::opt<std::string> OutputStatsFormat("o-stats-format",
+  cl::desc("Format of the statistics file written with -print-stats-csv or -o-stats: csv (default) or jsonl, "
+           "a JSON record per file and one for all the files"),
+  cl::value_desc("csv|jsonl"),
+  cl::init("csv"),
+  cl::cat(ToolTemplateCategory));
+
 cl::opt<bool> Examine("examine",
   cl::desc("Combines -no-output and -print-stats options"),
   cl::value_desc("examine"),
@@ -138,6 +192,16 @@ cl::opt<bool> SkipExcludedPPConditionalBlocks("skip-excluded-preprocessor-condit
   cl::value_desc("skip-excluded-preprocessor-conditional-blocks"),
   cl::cat(ToolTemplateCategory));
 
+cl::opt<bool> SkipFunctionBodiesOutsideMainFile("skip-function-bodies-outside-main-file",
+  cl::desc("Skip parsing of function bodies declared outside the main file (in CUDA and other included headers)"),
+  cl::value_desc("skip-function-bodies-outside-main-file"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<bool> UseASTVisitor("use-ast-visitor",
+  cl::desc("Use a single AST visitor pass instead of AST matchers"),
+  cl::value_desc("use-ast-visitor"),
+  cl::cat(ToolTemplateCategory));
+
 cl::opt<std::string> CudaGpuArch("cuda-gpu-arch",
   cl::desc("CUDA GPU architecture (e.g. sm_35);\nmay be specified more than once"),
   cl::value_desc("value"),
@@ -155,4 +219,40 @@ cl::opt<bool> GenerateCSV("csv",
   cl::value_desc("csv"),
   cl::cat(ToolTemplateCategory));
 
+cl::list<std::string> MappingOverlays("mapping-overlay",
+  cl::desc("File with additional or overriding CUDA to HIP mappings: either a text file with\n"
+           "'<CUDA name> <HIP name> <ROC name> <CONV_ type> <API_ type> [<flags>]' lines\n"
+           "or a mappings database generated by -mappings-db; may be specified more than once"),
+  cl::value_desc("filename"),
+  cl::ZeroOrMore,
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<bool> CheckMappings("check-mappings",
+  cl::desc("Check that no CUDA name is mapped to different HIP names by different APIs"),
+  cl::value_desc("check-mappings"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<std::string> TargetCudaVersion("cuda-version",
+  cl::desc("CUDA version of the sources to hipify: the CUDA APIs, deprecated or removed\n"
+           "as of the version, are reported as such"),
+  cl::value_desc("major.minor"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<std::string> TargetHipVersion("hip-version",
+  cl::desc("HIP version to hipify to: the HIP APIs, which are not yet or no longer\n"
+           "available in the version, are treated as unsupported"),
+  cl::value_desc("major.minor.patch"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<bool> Lex("lex",
+  cl::desc("Hipify without clang, by a lexical scan of the sources by the hipify-perl rules, on all the hardware threads"),
+  cl::value_desc("lex"),
+  cl::cat(ToolTemplateCategory));
+
+cl::opt<unsigned> Jobs("j",
+  cl::desc("Number of threads hipifying the sources with -lex (default: all the hardware threads)"),
+  cl::value_desc("N"),
+  cl::init(0),
+  cl::cat(ToolTemplateCategory));
+
 cl::extrahelp CommonHelp(ct::CommonOptionsParser::HelpMessage);
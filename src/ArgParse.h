@@ -32,6 +32,7 @@ extern cl::OptionCategory ToolTemplateCategory;
 extern cl::opt<std::string> OutputFilename;
 extern cl::opt<std::string> OutputHipifyPerlDir;
 extern cl::opt<std::string> OutputPythonMapDir;
+extern cl::opt<std::string> OutputMappingsDBDir;
 extern cl::opt<std::string> OutputDir;
 extern cl::opt<std::string> TemporaryDir;
 extern cl::opt<std::string> CudaPath;
@@ -41,17 +42,34 @@ extern cl::opt<bool> Inplace;
 extern cl::opt<bool> SaveTemps;
 extern cl::opt<bool> GeneratePerl;
 extern cl::opt<bool> GeneratePython;
+extern cl::opt<bool> GenerateMappingsDB;
 extern cl::opt<bool> Verbose;
 extern cl::opt<bool> NoBackup;
 extern cl::opt<bool> NoOutput;
 extern cl::opt<bool> PrintStats;
 extern cl::opt<bool> PrintStatsCSV;
+extern cl::opt<bool> PrintMatcherProfile;
+extern cl::opt<bool> PrintStartupProfile;
+extern cl::opt<std::string> OutputStartupProfileFilename;
 extern cl::opt<std::string> OutputStatsFilename;
+extern cl::opt<std::string> OutputStatsFormat;
+extern cl::opt<unsigned> PrintTopAPIs;
+extern cl::opt<bool> EmitUsageIndex;
+extern cl::opt<std::string> OutputUsageIndexFilename;
+extern cl::opt<std::string> QueryUsage;
 extern cl::opt<bool> Examine;
 extern cl::extrahelp CommonHelp;
 extern cl::opt<bool> TranslateToRoc;
 extern cl::opt<bool> DashDash;
 extern cl::opt<bool> SkipExcludedPPConditionalBlocks;
+extern cl::opt<bool> SkipFunctionBodiesOutsideMainFile;
+extern cl::opt<bool> UseASTVisitor;
 extern cl::opt<std::string> CudaGpuArch;
 extern cl::opt<bool> GenerateMarkdown;
 extern cl::opt<bool> GenerateCSV;
+extern cl::opt<bool> CheckMappings;
+extern cl::list<std::string> MappingOverlays;
+extern cl::opt<std::string> TargetCudaVersion;
+extern cl::opt<std::string> TargetHipVersion;
+extern cl::opt<bool> Lex;
+extern cl::opt<unsigned> Jobs;
@@ -21,9 +21,11 @@ THE SOFTWARE.
 */
 
 #include "CUDA2HIP.h"
+#include "LLVMCompat.h"
+#include "MappingsTable.h"
 
 // Maps CUDA header names to HIP header names
-const std::map <llvm::StringRef, hipCounter> CUDA_INCLUDE_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_INCLUDE_MAP {
   // CUDA includes
   {"cuda.h",                    {"hip/hip_runtime.h",            "", CONV_INCLUDE_CUDA_MAIN_H, API_DRIVER, 0}},
   {"cuda_runtime.h",            {"hip/hip_runtime.h",            "", CONV_INCLUDE_CUDA_MAIN_H, API_RUNTIME, 0}},
@@ -82,28 +84,76 @@ const std::map <llvm::StringRef, hipCounter> CUDA_INCLUDE_MAP {
   {"caffe2/core/common_cudnn.h",                            {"caffe2/core/hip/common_miopen.h",                       "", CONV_INCLUDE, API_CAFFE2, 0}},
 };
 
-const std::map<llvm::StringRef, hipCounter> &CUDA_RENAMES_MAP() {
-  static std::map<llvm::StringRef, hipCounter> ret;
-  if (!ret.empty())
-    return ret;
-  // First run, so compute the union map.
-  ret.insert(CUDA_DRIVER_TYPE_NAME_MAP.begin(), CUDA_DRIVER_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_DRIVER_FUNCTION_MAP.begin(), CUDA_DRIVER_FUNCTION_MAP.end());
-  ret.insert(CUDA_RUNTIME_TYPE_NAME_MAP.begin(), CUDA_RUNTIME_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_RUNTIME_FUNCTION_MAP.begin(), CUDA_RUNTIME_FUNCTION_MAP.end());
-  ret.insert(CUDA_COMPLEX_TYPE_NAME_MAP.begin(), CUDA_COMPLEX_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_COMPLEX_FUNCTION_MAP.begin(), CUDA_COMPLEX_FUNCTION_MAP.end());
-  ret.insert(CUDA_BLAS_TYPE_NAME_MAP.begin(), CUDA_BLAS_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_BLAS_FUNCTION_MAP.begin(), CUDA_BLAS_FUNCTION_MAP.end());
-  ret.insert(CUDA_RAND_TYPE_NAME_MAP.begin(), CUDA_RAND_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_RAND_FUNCTION_MAP.begin(), CUDA_RAND_FUNCTION_MAP.end());
-  ret.insert(CUDA_DNN_TYPE_NAME_MAP.begin(), CUDA_DNN_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_DNN_FUNCTION_MAP.begin(), CUDA_DNN_FUNCTION_MAP.end());
-  ret.insert(CUDA_FFT_TYPE_NAME_MAP.begin(), CUDA_FFT_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_FFT_FUNCTION_MAP.begin(), CUDA_FFT_FUNCTION_MAP.end());
-  ret.insert(CUDA_SPARSE_TYPE_NAME_MAP.begin(), CUDA_SPARSE_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_SPARSE_FUNCTION_MAP.begin(), CUDA_SPARSE_FUNCTION_MAP.end());
-  ret.insert(CUDA_CAFFE2_TYPE_NAME_MAP.begin(), CUDA_CAFFE2_TYPE_NAME_MAP.end());
-  ret.insert(CUDA_CAFFE2_FUNCTION_MAP.begin(), CUDA_CAFFE2_FUNCTION_MAP.end());
-  return ret;
+// The maps merged into CUDA_RENAMES_MAP; for the same CUDA name in several maps the first one wins.
+const renamesTable RENAMES_TABLES[] = {
+  {"CUDA_DRIVER_TYPE_NAME_MAP", CUDA_DRIVER_TYPE_NAME_MAP, CUDA_DRIVER_TYPE_NAME_VER_MAP, HIP_DRIVER_TYPE_NAME_VER_MAP},
+  {"CUDA_DRIVER_FUNCTION_MAP", CUDA_DRIVER_FUNCTION_MAP, CUDA_DRIVER_FUNCTION_VER_MAP, HIP_DRIVER_FUNCTION_VER_MAP},
+  {"CUDA_RUNTIME_TYPE_NAME_MAP", CUDA_RUNTIME_TYPE_NAME_MAP, CUDA_RUNTIME_TYPE_NAME_VER_MAP, HIP_RUNTIME_TYPE_NAME_VER_MAP},
+  {"CUDA_RUNTIME_FUNCTION_MAP", CUDA_RUNTIME_FUNCTION_MAP, CUDA_RUNTIME_FUNCTION_VER_MAP, HIP_RUNTIME_FUNCTION_VER_MAP},
+  {"CUDA_COMPLEX_TYPE_NAME_MAP", CUDA_COMPLEX_TYPE_NAME_MAP, CUDA_COMPLEX_TYPE_NAME_VER_MAP, HIP_COMPLEX_TYPE_NAME_VER_MAP},
+  {"CUDA_COMPLEX_FUNCTION_MAP", CUDA_COMPLEX_FUNCTION_MAP, CUDA_COMPLEX_FUNCTION_VER_MAP, HIP_COMPLEX_FUNCTION_VER_MAP},
+  {"CUDA_BLAS_TYPE_NAME_MAP", CUDA_BLAS_TYPE_NAME_MAP, CUDA_BLAS_TYPE_NAME_VER_MAP, HIP_BLAS_TYPE_NAME_VER_MAP},
+  {"CUDA_BLAS_FUNCTION_MAP", CUDA_BLAS_FUNCTION_MAP, CUDA_BLAS_FUNCTION_VER_MAP, HIP_BLAS_FUNCTION_VER_MAP},
+  {"CUDA_RAND_TYPE_NAME_MAP", CUDA_RAND_TYPE_NAME_MAP, CUDA_RAND_TYPE_NAME_VER_MAP, HIP_RAND_TYPE_NAME_VER_MAP},
+  {"CUDA_RAND_FUNCTION_MAP", CUDA_RAND_FUNCTION_MAP, CUDA_RAND_FUNCTION_VER_MAP, HIP_RAND_FUNCTION_VER_MAP},
+  {"CUDA_DNN_TYPE_NAME_MAP", CUDA_DNN_TYPE_NAME_MAP, CUDA_DNN_TYPE_NAME_VER_MAP, HIP_DNN_TYPE_NAME_VER_MAP},
+  {"CUDA_DNN_FUNCTION_MAP", CUDA_DNN_FUNCTION_MAP, CUDA_DNN_FUNCTION_VER_MAP, HIP_DNN_FUNCTION_VER_MAP},
+  {"CUDA_FFT_TYPE_NAME_MAP", CUDA_FFT_TYPE_NAME_MAP, CUDA_FFT_TYPE_NAME_VER_MAP, HIP_FFT_TYPE_NAME_VER_MAP},
+  {"CUDA_FFT_FUNCTION_MAP", CUDA_FFT_FUNCTION_MAP, CUDA_FFT_FUNCTION_VER_MAP, HIP_FFT_FUNCTION_VER_MAP},
+  {"CUDA_SPARSE_TYPE_NAME_MAP", CUDA_SPARSE_TYPE_NAME_MAP, CUDA_SPARSE_TYPE_NAME_VER_MAP, HIP_SPARSE_TYPE_NAME_VER_MAP},
+  {"CUDA_SPARSE_FUNCTION_MAP", CUDA_SPARSE_FUNCTION_MAP, CUDA_SPARSE_FUNCTION_VER_MAP, HIP_SPARSE_FUNCTION_VER_MAP},
+  {"CUDA_CAFFE2_TYPE_NAME_MAP", CUDA_CAFFE2_TYPE_NAME_MAP, CUDA_CAFFE2_TYPE_NAME_VER_MAP, HIP_CAFFE2_TYPE_NAME_VER_MAP},
+  {"CUDA_CAFFE2_FUNCTION_MAP", CUDA_CAFFE2_FUNCTION_MAP, CUDA_CAFFE2_FUNCTION_VER_MAP, HIP_CAFFE2_FUNCTION_VER_MAP},
 };
+
+llvm::ArrayRef<renamesTable> CUDA_RENAMES_TABLES() {
+  return RENAMES_TABLES;
+}
+
+namespace {
+
+SortedMap<llvm::StringRef, const hipCounter*> mergeRenames() {
+  SortedMap<llvm::StringRef, const hipCounter*> ret;
+  const MappingsTable &table = MappingsTable::get();
+  // The renames of the table are already merged and sorted, so the insert is just a copy.
+  std::vector<std::pair<llvm::StringRef, const hipCounter*>> entries;
+  entries.reserve(table.getRenames().size());
+  for (auto id : table.getRenames()) {
+    entries.push_back({table.getCudaName(id), &table.getCounter(id)});
+  }
+  ret.reserve(entries.size());
+  ret.insert(entries.begin(), entries.end());
+  return ret;
+}
+
+}
+
+const SortedMap<llvm::StringRef, const hipCounter*> &CUDA_RENAMES_MAP() {
+  static const SortedMap<llvm::StringRef, const hipCounter*> ret = mergeRenames();
+  return ret;
+}
+
+bool checkRenames() {
+  bool bConflict = false;
+  for (auto &ma : CUDA_RENAMES_MAP()) {
+    const renamesTable *first = nullptr;
+    const hipCounter *firstCounter = nullptr;
+    for (auto &table : RENAMES_TABLES) {
+      const auto found = table.map.find(ma.first);
+      if (found == table.map.end()) continue;
+      if (!first) {
+        first = &table;
+        firstCounter = &found->second;
+        continue;
+      }
+      const hipCounter &counter = found->second;
+      // The same CUDA name may belong to several APIs, but then it should be mapped to the same HIP name.
+      if (Statistics::isUnsupported(*firstCounter) && Statistics::isUnsupported(counter)) continue;
+      if (firstCounter->hipName == counter.hipName && firstCounter->rocName == counter.rocName) continue;
+      llvm::errs() << sHipify << sConflict << ma.first << " is mapped to " << firstCounter->hipName << " in " << first->name
+                   << " and to " << counter.hipName << " in " << table.name << "\n";
+      bConflict = true;
+    }
+  }
+  return !bConflict;
+}
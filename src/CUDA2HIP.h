@@ -23,109 +23,134 @@ THE SOFTWARE.
 #pragma once
 
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/ArrayRef.h"
 #include <set>
-#include <map>
+#include "SortedMap.h"
 #include "Statistics.h"
 
 // Maps CUDA header names to HIP header names
-extern const std::map<llvm::StringRef, hipCounter> CUDA_INCLUDE_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_INCLUDE_MAP;
 // Maps the names of CUDA DRIVER API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_DRIVER_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_DRIVER_TYPE_NAME_MAP;
 // Maps the names of CUDA DRIVER API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_DRIVER_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_DRIVER_FUNCTION_MAP;
 // Maps the names of CUDA RUNTIME API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_RUNTIME_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_RUNTIME_TYPE_NAME_MAP;
 // Maps the names of CUDA Complex API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_COMPLEX_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_COMPLEX_TYPE_NAME_MAP;
 // Maps the names of CUDA Complex API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_COMPLEX_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_COMPLEX_FUNCTION_MAP;
 // Maps the names of CUDA RUNTIME API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_RUNTIME_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_RUNTIME_FUNCTION_MAP;
 // Maps the names of CUDA BLAS API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_BLAS_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_BLAS_TYPE_NAME_MAP;
 // Maps the names of CUDA BLAS API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_BLAS_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_BLAS_FUNCTION_MAP;
 // Maps the names of CUDA RAND API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_RAND_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_RAND_TYPE_NAME_MAP;
 // Maps the names of CUDA RAND API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_RAND_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_RAND_FUNCTION_MAP;
 // Maps the names of CUDA DNN API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_DNN_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_DNN_TYPE_NAME_MAP;
 // Maps the names of CUDA DNN API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_DNN_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_DNN_FUNCTION_MAP;
 // Maps the names of CUDA FFT API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_FFT_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_FFT_TYPE_NAME_MAP;
 // Maps the names of CUDA FFT API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_FFT_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_FFT_FUNCTION_MAP;
 // Maps the names of CUDA SPARSE API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_SPARSE_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_SPARSE_TYPE_NAME_MAP;
 // Maps the names of CUDA SPARSE API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_SPARSE_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_SPARSE_FUNCTION_MAP;
 // Maps the names of CUDA CAFFE2 API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_CAFFE2_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_CAFFE2_TYPE_NAME_MAP;
 // Maps the names of CUDA CAFFE2 API functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_CAFFE2_FUNCTION_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_CAFFE2_FUNCTION_MAP;
 // Maps the names of CUDA Device functions to the corresponding HIP functions
-extern const std::map<llvm::StringRef, hipCounter> CUDA_DEVICE_FUNC_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_DEVICE_FUNC_MAP;
 // Maps the names of CUDA CUB API types to the corresponding HIP types
-extern const std::map<llvm::StringRef, hipCounter> CUDA_CUB_TYPE_NAME_MAP;
+extern const SortedMap<llvm::StringRef, hipCounter> CUDA_CUB_TYPE_NAME_MAP;
+
+struct renamesTable {
+  const char *name;
+  const SortedMap<llvm::StringRef, hipCounter> &map;
+  const SortedMap<llvm::StringRef, cudaAPIversions> &cudaVersions;
+  const SortedMap<llvm::StringRef, hipAPIversions> &hipVersions;
+};
+
+// The maps, which make up CUDA_RENAMES_MAP, with their versions, in the order of priority
+llvm::ArrayRef<renamesTable> CUDA_RENAMES_TABLES();
 
 /**
-  * The union of all the above maps, except includes.
+  * The union of all the above maps, except includes, Device functions and CUB.
   *
   * This should be used rarely, but is still needed to convert macro definitions (which can
   * contain any combination of the above things). AST walkers can usually get away with just
   * looking in the lookup table for the type of element they are processing, however, saving
   * a great deal of time.
+  *
+  * The union doesn't copy the entries: it points to the entries of the above maps or, if they are targeted
+  * to other versions by -cuda-version or -hip-version, to their targeted copies in MappingsTable.
+  */
+const SortedMap<llvm::StringRef, const hipCounter*> &CUDA_RENAMES_MAP();
+/**
+  * Loads additional or overriding mappings for CUDA_RENAMES_MAP from a mappings database (-mappings-db) or
+  * from a text file with a mapping per line: <CUDA name> <HIP name> <ROC name> <CONV_ type> <API_ type> [<flags>],
+  * where "-" stands for an empty name, and flags are SupportDegree names joined by '|'; '#' starts a comment.
+  * Should be called before the first use of CUDA_RENAMES_MAP.
   */
-const std::map<llvm::StringRef, hipCounter> &CUDA_RENAMES_MAP();
+bool loadMappingOverlay(llvm::StringRef path);
+// The loaded overlay mappings, in the order of loading.
+llvm::ArrayRef<std::pair<llvm::StringRef, const hipCounter*>> CUDA_RENAMES_OVERLAY();
+// Reports the CUDA names, which are mapped to different HIP names by the maps of the union; returns false if any.
+bool checkRenames();
 
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_DRIVER_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_DRIVER_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_DRIVER_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_DRIVER_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_RUNTIME_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_RUNTIME_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_RUNTIME_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_RUNTIME_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_COMPLEX_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_COMPLEX_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_BLAS_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_BLAS_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_BLAS_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_BLAS_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_RAND_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_RAND_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_RAND_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_RAND_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_DNN_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_DNN_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_DNN_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_DNN_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_FFT_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_FFT_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_FFT_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_FFT_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_SPARSE_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_SPARSE_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_SPARSE_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_SPARSE_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_CAFFE2_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_CAFFE2_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_CAFFE2_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_CAFFE2_FUNCTION_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_DEVICE_FUNC_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_DEVICE_FUNC_VER_MAP;
-extern const std::map<llvm::StringRef, cudaAPIversions> CUDA_CUB_TYPE_NAME_VER_MAP;
-extern const std::map<llvm::StringRef, hipAPIversions>  HIP_CUB_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DRIVER_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_DRIVER_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DRIVER_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_DRIVER_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_RUNTIME_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_RUNTIME_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_RUNTIME_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_RUNTIME_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_COMPLEX_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_COMPLEX_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_BLAS_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_BLAS_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_BLAS_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_BLAS_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_RAND_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_RAND_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_RAND_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_RAND_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DNN_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_DNN_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DNN_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_DNN_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_FFT_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_FFT_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_FFT_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_FFT_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_SPARSE_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_SPARSE_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_SPARSE_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_SPARSE_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_CAFFE2_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_CAFFE2_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_CAFFE2_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_CAFFE2_FUNCTION_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DEVICE_FUNC_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_DEVICE_FUNC_VER_MAP;
+extern const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_CUB_TYPE_NAME_VER_MAP;
+extern const SortedMap<llvm::StringRef, hipAPIversions>  HIP_CUB_TYPE_NAME_VER_MAP;
 
-extern const std::map<unsigned int, llvm::StringRef> CUDA_DRIVER_API_SECTION_MAP;
-extern const std::map<unsigned int, llvm::StringRef> CUDA_RUNTIME_API_SECTION_MAP;
-extern const std::map<unsigned int, llvm::StringRef> CUDA_COMPLEX_API_SECTION_MAP;
-extern const std::map<unsigned int, llvm::StringRef> CUDA_BLAS_API_SECTION_MAP;
-extern const std::map<unsigned int, llvm::StringRef> CUDA_RAND_API_SECTION_MAP;
-extern const std::map<unsigned int, llvm::StringRef> CUDA_DNN_API_SECTION_MAP;
-extern const std::map<unsigned int, llvm::StringRef> CUDA_FFT_API_SECTION_MAP;
-extern const std::map<unsigned int, llvm::StringRef> CUDA_SPARSE_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_DRIVER_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_RUNTIME_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_COMPLEX_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_BLAS_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_RAND_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_DNN_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_FFT_API_SECTION_MAP;
+extern const SortedMap<unsigned int, llvm::StringRef> CUDA_SPARSE_API_SECTION_MAP;
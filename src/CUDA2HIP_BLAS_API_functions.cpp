@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_BLAS_FUNCTION_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_BLAS_FUNCTION_MAP {
 
   // Blas management functions
   {"cublasInit",                     {"hipblasInit",                     "",                                         CONV_LIB_FUNC, API_BLAS, 4, UNSUPPORTED}},
@@ -669,7 +669,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_BLAS_FUNCTION_MAP {
   {"cublasDrotmg_v2",                {"hipblasDrotmg",                   "rocblas_drotmg",                           CONV_LIB_FUNC, API_BLAS, 5}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_BLAS_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_BLAS_FUNCTION_VER_MAP {
   {"cublasGetMathMode",                          {CUDA_90,  CUDA_0, CUDA_0}},
   {"cublasMigrateComputeType",                   {CUDA_110, CUDA_0, CUDA_0}},
   {"cublasLogCallback",                          {CUDA_92,  CUDA_0, CUDA_0}},
@@ -715,10 +715,10 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_BLAS_FUNCTION_VER_MAP {
   {"cublasRotmgEx",                              {CUDA_101, CUDA_0, CUDA_0}},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_BLAS_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_BLAS_FUNCTION_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_BLAS_API_SECTION_MAP {
+const SortedMap<unsigned int, llvm::StringRef> CUDA_BLAS_API_SECTION_MAP {
   {2, "CUBLAS Data types"},
   {3, "CUDA Datatypes Reference"},
   {4, "CUBLAS Helper Function Reference"},
@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_BLAS_TYPE_NAME_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_BLAS_TYPE_NAME_MAP {
   // Blas defines
   {"CUBLAS_VER_MAJOR",               {"HIPBLAS_VER_MAJOR",               "",                                      CONV_DEFINE, API_BLAS, 2, HIP_UNSUPPORTED}},
   {"CUBLAS_VER_MINOR",               {"HIPBLAS_VER_MINOR",               "",                                      CONV_DEFINE, API_BLAS, 2, HIP_UNSUPPORTED}},
@@ -173,7 +173,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_BLAS_TYPE_NAME_MAP {
   {"CUBLAS_COMPUTE_32I_PEDANTIC",    {"HIPBLAS_COMPUTE_32I_PEDANTIC",    "",                                      CONV_NUMERIC_LITERAL, API_BLAS, 2, UNSUPPORTED}}, // 73
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_BLAS_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_BLAS_TYPE_NAME_VER_MAP {
   {"CUBLAS_VER_MAJOR",                                 {CUDA_101, CUDA_0, CUDA_0}},
   {"CUBLAS_VER_MINOR",                                 {CUDA_101, CUDA_0, CUDA_0}},
   {"CUBLAS_VER_PATCH",                                 {CUDA_101, CUDA_0, CUDA_0}},
@@ -264,5 +264,5 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_BLAS_TYPE_NAME_VER_MAP {
   {"CUBLAS_COMPUTE_32I_PEDANTIC",                      {CUDA_110, CUDA_0, CUDA_0}},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_BLAS_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_BLAS_TYPE_NAME_VER_MAP {
 };
@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all types
-const std::map<llvm::StringRef, hipCounter> CUDA_CAFFE2_TYPE_NAME_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_CAFFE2_TYPE_NAME_MAP {
 
   // 5. Defines
   {"REGISTER_CUDA_OPERATOR",                                  {"REGISTER_HIP_OPERATOR",                                        "", CONV_DEFINE, API_CAFFE2, 1}},
@@ -33,5 +33,8 @@ const std::map<llvm::StringRef, hipCounter> CUDA_CAFFE2_TYPE_NAME_MAP {
   {"CUDAContext",                                             {"HIPContext",                                                   "", CONV_TYPE, API_CAFFE2, 1}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_CAFFE2_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_CAFFE2_TYPE_NAME_VER_MAP {
+};
+
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_CAFFE2_TYPE_NAME_VER_MAP {
 };
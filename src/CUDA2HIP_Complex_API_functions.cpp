@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Maps the names of CUDA Complex API functions to the corresponding HIP functions
-const std::map<llvm::StringRef, hipCounter> CUDA_COMPLEX_FUNCTION_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_COMPLEX_FUNCTION_MAP {
   {"cuCrealf",               {"hipCrealf",               "", CONV_COMPLEX, API_COMPLEX, 2}},
   {"cuCimagf",               {"hipCimagf",               "", CONV_COMPLEX, API_COMPLEX, 2}},
   {"make_cuFloatComplex",    {"make_hipFloatComplex",    "", CONV_COMPLEX, API_COMPLEX, 2}},
@@ -49,13 +49,13 @@ const std::map<llvm::StringRef, hipCounter> CUDA_COMPLEX_FUNCTION_MAP {
   {"cuCfma",                 {"hipCfma",                 "", CONV_COMPLEX, API_COMPLEX, 2}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_FUNCTION_VER_MAP {
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_COMPLEX_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_COMPLEX_FUNCTION_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_COMPLEX_API_SECTION_MAP {
+const SortedMap<unsigned int, llvm::StringRef> CUDA_COMPLEX_API_SECTION_MAP {
   {1, "cuComplex Data types"},
   {2, "cuComplex API functions"},
 };
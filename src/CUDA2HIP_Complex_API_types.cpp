@@ -23,14 +23,14 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Maps the names of CUDA Complex API types to the corresponding HIP types
-const std::map<llvm::StringRef, hipCounter> CUDA_COMPLEX_TYPE_NAME_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_COMPLEX_TYPE_NAME_MAP {
   {"cuFloatComplex",  {"hipFloatComplex",  "", CONV_TYPE, API_COMPLEX, 1}},
   {"cuDoubleComplex", {"hipDoubleComplex", "", CONV_TYPE, API_COMPLEX, 1}},
   {"cuComplex",       {"hipComplex",       "", CONV_TYPE, API_COMPLEX, 1}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_COMPLEX_TYPE_NAME_VER_MAP {
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_COMPLEX_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_COMPLEX_TYPE_NAME_VER_MAP {
 };
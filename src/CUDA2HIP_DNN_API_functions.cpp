@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_DNN_FUNCTION_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_DNN_FUNCTION_MAP {
 
   {"cudnnGetVersion",                                     {"hipdnnGetVersion",                                     "", CONV_LIB_FUNC, API_DNN, 2}},
   {"cudnnGetCudartVersion",                               {"hipdnnGetCudartVersion",                               "", CONV_LIB_FUNC, API_DNN, 2, HIP_UNSUPPORTED}},
@@ -336,7 +336,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_DNN_FUNCTION_MAP {
   {"cudnnBackendExecute",                                 {"hipdnnBackendExecute",                                 "", CONV_LIB_FUNC, API_DNN, 2, HIP_UNSUPPORTED}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_DNN_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DNN_FUNCTION_VER_MAP {
   {"cudnnCreateRNNDescriptor",                            {CUDNN_50,  CUDA_0,    CUDA_0   }},
   {"cudnnDestroyRNNDescriptor",                           {CUDNN_50,  CUDA_0,    CUDA_0   }},
   {"cudnnSetRNNDescriptor_v8",                            {CUDNN_801, CUDA_0,    CUDA_0   }},
@@ -606,10 +606,10 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_DNN_FUNCTION_VER_MAP {
   {"cudnnSetRNNDescriptor_v5",                            {CUDNN_705, CUDNN_765, CUDNN_801}},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_DNN_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_DNN_FUNCTION_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_DNN_API_SECTION_MAP {
+const SortedMap<unsigned int, llvm::StringRef> CUDA_DNN_API_SECTION_MAP {
   {1, "CUNN Data types"},
   {2, "CUNN Functions"},
 };
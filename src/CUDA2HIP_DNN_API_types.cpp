@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_DNN_TYPE_NAME_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_DNN_TYPE_NAME_MAP {
   // cuDNN defines
   {"CUDNN_VERSION",                                                  {"HIPDNN_VERSION",                                                  "", CONV_NUMERIC_LITERAL, API_DNN, 1}},
   {"CUDNN_DIM_MAX",                                                  {"HIPDNN_DIM_MAX",                                                  "", CONV_NUMERIC_LITERAL, API_DNN, 1, HIP_UNSUPPORTED}},    //  8
@@ -539,7 +539,6 @@ const std::map<llvm::StringRef, hipCounter> CUDA_DNN_TYPE_NAME_MAP {
   {"CUDNN_HEUR_MODES_COUNT",                                         {"HIPDNN_HEUR_MODES_COUNT",                                         "", CONV_NUMERIC_LITERAL, API_DNN, 1, HIP_UNSUPPORTED}},
   {"cudnnNormMode_t",                                                {"hipdnnNormMode_t",                                                "", CONV_TYPE, API_DNN, 1, HIP_UNSUPPORTED}},
   {"CUDNN_NORM_PER_ACTIVATION",                                      {"HIPDNN_NORM_PER_ACTIVATION",                                      "", CONV_NUMERIC_LITERAL, API_DNN, 1, HIP_UNSUPPORTED}},
-  {"CUDNN_HEUR_MODES_COUNT",                                         {"HIPDNN_HEUR_MODES_COUNT",                                         "", CONV_NUMERIC_LITERAL, API_DNN, 1, HIP_UNSUPPORTED}},
   {"CUDNN_NORM_PER_CHANNEL",                                         {"HIPDNN_NORM_PER_CHANNEL",                                         "", CONV_NUMERIC_LITERAL, API_DNN, 1, HIP_UNSUPPORTED}},
   {"cudnnNormAlgo_t",                                                {"hipdnnNormAlgo_t",                                                "", CONV_TYPE, API_DNN, 1, HIP_UNSUPPORTED}},
   {"CUDNN_NORM_ALGO_STANDARD",                                       {"HIPDNN_NORM_ALGO_STANDARD",                                       "", CONV_NUMERIC_LITERAL, API_DNN, 1, HIP_UNSUPPORTED}},
@@ -607,7 +606,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_DNN_TYPE_NAME_MAP {
   {"libraryPropertyType_t",                                          {"hipdnnLibraryPropertyType_t",                                     "", CONV_TYPE, API_DNN, 1, HIP_UNSUPPORTED}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_DNN_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DNN_TYPE_NAME_VER_MAP {
   {"CUDNN_MAJOR",                                                    {CUDNN_30,  CUDA_0,   CUDA_0  }},
   {"CUDNN_MINOR",                                                    {CUDNN_30,  CUDA_0,   CUDA_0  }},
   {"CUDNN_PATCHLEVEL",                                               {CUDNN_30,  CUDA_0,   CUDA_0  }},
@@ -1187,5 +1186,5 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_DNN_TYPE_NAME_VER_MAP {
   {"cudnnCallback_t",                                                {CUDNN_713, CUDA_0,   CUDA_0  }},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_DNN_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_DNN_TYPE_NAME_VER_MAP {
 };
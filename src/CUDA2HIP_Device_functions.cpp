@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Maps CUDA header names to HIP header names
-const std::map<llvm::StringRef, hipCounter> CUDA_DEVICE_FUNC_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_DEVICE_FUNC_MAP {
   // math functions
   {"abs",             {"", "", CONV_DEVICE_FUNC, API_RUNTIME, 1}},
   {"labs",            {"", "", CONV_DEVICE_FUNC, API_RUNTIME, 1}},
@@ -615,9 +615,12 @@ const std::map<llvm::StringRef, hipCounter> CUDA_DEVICE_FUNC_MAP {
   {"atomicCAS",         {"", "", CONV_DEVICE_FUNC, API_RUNTIME, 1}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_DEVICE_FUNC_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DEVICE_FUNC_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_DEVICE_FUNC_SECTION_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_DEVICE_FUNC_VER_MAP {
+};
+
+const SortedMap<unsigned int, llvm::StringRef> CUDA_DEVICE_FUNC_SECTION_MAP {
   {1, "Device Functions"},
 };
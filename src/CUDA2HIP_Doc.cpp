@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <map>
 #include "CUDA2HIP.h"
 #include "CUDA2HIP_Scripting.h"
+#include "MappingsTable.h"
 #include "ArgParse.h"
 #include "StringUtils.h"
 #include "LLVMCompat.h"
@@ -34,11 +35,9 @@ namespace doc {
   using namespace std;
   using namespace llvm;
 
-  typedef map<unsigned int, StringRef> sectionMap;
-  typedef map<StringRef, hipCounter> functionMap;
+  typedef SortedMap<unsigned int, StringRef> sectionMap;
+  typedef SortedMap<StringRef, hipCounter> functionMap;
   typedef functionMap typeMap;
-  typedef map<StringRef, cudaAPIversions> versionMap;
-  typedef map<StringRef, hipAPIversions> hipVersionMap;
 
   const string sEmpty = "";
   const string sMd = "md";
@@ -108,7 +107,6 @@ namespace doc {
         if (init()) return write() & fini();
         return false;
       }
-      virtual void setCommonHipVersionMap() {}
 
     protected:
       virtual const string &getFileName(docType format) const = 0;
@@ -116,11 +114,6 @@ namespace doc {
       virtual const sectionMap &getSections() const = 0;
       virtual const functionMap &getFunctions() const = 0;
       virtual const typeMap &getTypes() const = 0;
-      virtual const versionMap &getFunctionVersions() const = 0;
-      virtual const hipVersionMap &getHipFunctionVersions() const = 0;
-      virtual const versionMap &getTypeVersions() const = 0;
-      virtual const hipVersionMap &getHipTypeVersions() const = 0;
-      hipVersionMap commonHipVersionMap;
 
     private:
       string dir;
@@ -164,28 +157,19 @@ namespace doc {
             *streams[md].get() << "## **" << s.first << ". " << string(s.second) << "**" << endl << endl;
             *streams[md].get() << "| **" << sCUDA << "** | **" << sA << "** | **" << sD << "** | **" << sR << "** | **" << sHIP << "** | **" << sA << "** | **" << sD << "** | **" << sR << "** |" << endl;
             *streams[md].get() << "|:--|:-:|:-:|:-:|:--|:-:|:-:|:-:|" << endl;
-            const functionMap &ftMap = isTypeSection(s.first, getSections()) ? getTypes() : getFunctions();
-            const versionMap &vMap = isTypeSection(s.first, getSections()) ? getTypeVersions() : getFunctionVersions();
-            const hipVersionMap &hMap = commonHipVersionMap.empty() ? (isTypeSection(s.first, getSections()) ? getHipTypeVersions() : getHipFunctionVersions()) : commonHipVersionMap;
-            functionMap fMap;
-            for (auto &f : ftMap) if (f.second.apiSection == s.first) fMap.insert(f);
-            for (auto &f : fMap) {
-              string a, d, r, ha, hd, hr;
-              for (auto &v : vMap) {
-                if (v.first == f.first) {
-                  a = Statistics::getCudaVersion(v.second.appeared);
-                  d = Statistics::getCudaVersion(v.second.deprecated);
-                  r = Statistics::getCudaVersion(v.second.removed);
-                  break;
-                }
-              }
-              auto hv = hMap.find(f.second.hipName);
-              if (hv != hMap.end()) {
-                ha = Statistics::getHipVersion(hv->second.appeared);
-                hd = Statistics::getHipVersion(hv->second.deprecated);
-                hr = Statistics::getHipVersion(hv->second.removed);
-              }
-              *streams[md].get() << "|`" << string(f.first) << "`| " << a << " | " << d << " | " << r << " |" << (Statistics::isHipUnsupported(f.second) ? "" : "`" + string(f.second.hipName) + "`") << "| " << ha << " | " << hd << " | " << hr << " |" << endl;
+            const MappingsTable &table = MappingsTable::get();
+            for (auto id : table.getIDs(isTypeSection(s.first, getSections()) ? getTypes() : getFunctions())) {
+              const hipCounter &counter = table.getCounter(id);
+              if (counter.apiSection != s.first) continue;
+              const cudaAPIversions &cudaVer = table.getCudaVersions(id);
+              const hipAPIversions &hipVer = table.getHipVersions(id);
+              string a = Statistics::getCudaVersion(cudaVer.appeared);
+              string d = Statistics::getCudaVersion(cudaVer.deprecated);
+              string r = Statistics::getCudaVersion(cudaVer.removed);
+              string ha = Statistics::getHipVersion(hipVer.appeared);
+              string hd = Statistics::getHipVersion(hipVer.deprecated);
+              string hr = Statistics::getHipVersion(hipVer.removed);
+              *streams[md].get() << "|`" << string(table.getCudaName(id)) << "`| " << a << " | " << d << " | " << r << " |" << (Statistics::isHipUnsupported(counter) ? "" : "`" + string(counter.hipName) + "`") << "| " << ha << " | " << hd << " | " << hr << " |" << endl;
             }
             *streams[md].get() << endl;
           }
@@ -234,7 +218,6 @@ namespace doc {
       bool generate() {
         bool bRet = true;
         for (auto &d : docs) {
-          d->setCommonHipVersionMap();
           bRet = d->generate() & bRet;
         }
         return bRet;
@@ -249,10 +232,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_DRIVER_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_DRIVER_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_DRIVER_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_DRIVER_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_DRIVER_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_DRIVER_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_DRIVER_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCUDA_DRIVER; }
       const string &getFileName(docType format) const override {
         switch (format) {
@@ -262,12 +241,6 @@ namespace doc {
           case csv: return sDRIVER_csv;
         }
       }
-      void setCommonHipVersionMap() {
-        commonHipVersionMap.insert(HIP_DRIVER_FUNCTION_VER_MAP.begin(), HIP_DRIVER_FUNCTION_VER_MAP.end());
-        commonHipVersionMap.insert(HIP_DRIVER_TYPE_NAME_VER_MAP.begin(), HIP_DRIVER_TYPE_NAME_VER_MAP.end());
-        commonHipVersionMap.insert(HIP_RUNTIME_FUNCTION_VER_MAP.begin(), HIP_RUNTIME_FUNCTION_VER_MAP.end());
-        commonHipVersionMap.insert(HIP_RUNTIME_TYPE_NAME_VER_MAP.begin(), HIP_RUNTIME_TYPE_NAME_VER_MAP.end());
-      }
   };
 
   class RUNTIME : public DOC {
@@ -278,10 +251,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_RUNTIME_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_RUNTIME_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_RUNTIME_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_RUNTIME_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_RUNTIME_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_RUNTIME_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_RUNTIME_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCUDA_RUNTIME; }
       const string &getFileName(docType format) const override {
         switch (format) {
@@ -291,12 +260,6 @@ namespace doc {
           case csv: return sRUNTIME_csv;
         }
       }
-      void setCommonHipVersionMap() {
-        commonHipVersionMap.insert(HIP_DRIVER_FUNCTION_VER_MAP.begin(), HIP_DRIVER_FUNCTION_VER_MAP.end());
-        commonHipVersionMap.insert(HIP_DRIVER_TYPE_NAME_VER_MAP.begin(), HIP_DRIVER_TYPE_NAME_VER_MAP.end());
-        commonHipVersionMap.insert(HIP_RUNTIME_FUNCTION_VER_MAP.begin(), HIP_RUNTIME_FUNCTION_VER_MAP.end());
-        commonHipVersionMap.insert(HIP_RUNTIME_TYPE_NAME_VER_MAP.begin(), HIP_RUNTIME_TYPE_NAME_VER_MAP.end());
-      }
   };
 
   class COMPLEX : public DOC {
@@ -307,10 +270,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_COMPLEX_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_COMPLEX_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_COMPLEX_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_COMPLEX_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_COMPLEX_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_COMPLEX_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_COMPLEX_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCUCOMPLEX; }
       const string &getFileName(docType format) const override {
         switch (format) {
@@ -330,10 +289,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_BLAS_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_BLAS_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_BLAS_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_BLAS_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_BLAS_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_BLAS_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_BLAS_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCUBLAS; }
       const string &getFileName(docType format) const override {
         switch (format) {
@@ -353,10 +308,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_RAND_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_RAND_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_RAND_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_RAND_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_RAND_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_RAND_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_RAND_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCURAND; }
       const string &getFileName(docType format) const override {
         switch (format) {
@@ -376,10 +327,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_DNN_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_DNN_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_DNN_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_DNN_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_DNN_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_DNN_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_DNN_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCUDNN; }
       const string &getFileName(docType format) const override {
         switch (format) {
@@ -399,10 +346,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_FFT_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_FFT_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_FFT_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_FFT_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_FFT_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_FFT_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_FFT_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCUFFT; }
       const string &getFileName(docType format) const override {
         switch (format) {
@@ -422,10 +365,6 @@ namespace doc {
       const sectionMap &getSections() const override { return CUDA_SPARSE_API_SECTION_MAP; }
       const functionMap &getFunctions() const override { return CUDA_SPARSE_FUNCTION_MAP; }
       const typeMap &getTypes() const override { return CUDA_SPARSE_TYPE_NAME_MAP; }
-      const versionMap &getFunctionVersions() const override { return CUDA_SPARSE_FUNCTION_VER_MAP; }
-      const hipVersionMap &getHipFunctionVersions() const override { return HIP_SPARSE_FUNCTION_VER_MAP; }
-      const versionMap &getTypeVersions() const override { return CUDA_SPARSE_TYPE_NAME_VER_MAP; }
-      const hipVersionMap &getHipTypeVersions() const override { return HIP_SPARSE_TYPE_NAME_VER_MAP; }
       const string &getName() const override { return sCUSPARSE; }
       const string &getFileName(docType format) const override {
         switch (format) {
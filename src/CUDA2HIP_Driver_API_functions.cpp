@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all CUDA Driver API functions
-const std::map<llvm::StringRef, hipCounter> CUDA_DRIVER_FUNCTION_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_DRIVER_FUNCTION_MAP {
   // 2. Error Handling
   // no analogue
   // NOTE: cudaGetErrorName and cuGetErrorName have different signatures
@@ -867,7 +867,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_DRIVER_FUNCTION_MAP {
   {"cuEventCreateFromEGLSync",                             {"hipEventCreateFromEGLSync",                               "", CONV_EGL, API_DRIVER, 35, HIP_UNSUPPORTED}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_DRIVER_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_DRIVER_FUNCTION_VER_MAP {
   {"cuDeviceGetLuid",                                      {CUDA_100, CUDA_0,   CUDA_0  }},
   {"cuDeviceGetNvSciSyncAttributes",                       {CUDA_102, CUDA_0,   CUDA_0  }},
   {"cuDeviceGetUuid",                                      {CUDA_92,  CUDA_0,   CUDA_0  }},
@@ -1070,10 +1070,10 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_DRIVER_FUNCTION_VER_MAP {
   {"cuGraphUpload",                                        {CUDA_111, CUDA_0,   CUDA_0  }},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_DRIVER_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_DRIVER_FUNCTION_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_DRIVER_API_SECTION_MAP {
+const SortedMap<unsigned int, llvm::StringRef> CUDA_DRIVER_API_SECTION_MAP {
   {1, "CUDA Driver Data Types"},
   {2, "Error Handling"},
   {3, "Initialization"},
@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_FFT_FUNCTION_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_FFT_FUNCTION_MAP {
   {"cufftPlan1d",                                         {"hipfftPlan1d",                                         "", CONV_LIB_FUNC, API_FFT, 2}},
   {"cufftPlan2d",                                         {"hipfftPlan2d",                                         "", CONV_LIB_FUNC, API_FFT, 2}},
   {"cufftPlan3d",                                         {"hipfftPlan3d",                                         "", CONV_LIB_FUNC, API_FFT, 2}},
@@ -58,16 +58,16 @@ const std::map<llvm::StringRef, hipCounter> CUDA_FFT_FUNCTION_MAP {
   {"cufftGetProperty",                                    {"hipfftGetProperty",                                    "", CONV_LIB_FUNC, API_FFT, 2}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_FFT_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_FFT_FUNCTION_VER_MAP {
   {"cufftMakePlanMany64",                                 {CUDA_75,  CUDA_0, CUDA_0}},
   {"cufftGetSizeMany64",                                  {CUDA_75,  CUDA_0, CUDA_0}},
   {"cufftGetProperty",                                    {CUDA_80,  CUDA_0, CUDA_0}},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_FFT_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_FFT_FUNCTION_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_FFT_API_SECTION_MAP {
+const SortedMap<unsigned int, llvm::StringRef> CUDA_FFT_API_SECTION_MAP {
   {1, "CUFFT Data types"},
   {2, "CUFFT API functions"},
 };
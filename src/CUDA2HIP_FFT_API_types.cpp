@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_FFT_TYPE_NAME_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_FFT_TYPE_NAME_MAP {
 
   // cuFFT defines
   {"CUFFT_VER_MAJOR",                  {"HIPRAND_VER_MAJOR",                 "", CONV_DEFINE, API_FFT, 1, HIP_UNSUPPORTED}},
@@ -78,7 +78,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_FFT_TYPE_NAME_MAP {
   {"cufftHandle",                      {"hipfftHandle",                      "", CONV_TYPE, API_FFT, 1}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_FFT_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_FFT_TYPE_NAME_VER_MAP {
   {"CUFFT_VER_MAJOR",                  {CUDA_102, CUDA_0, CUDA_0}},
   {"CUFFT_VER_MINOR",                  {CUDA_102, CUDA_0, CUDA_0}},
   {"CUFFT_VER_PATCH",                  {CUDA_102, CUDA_0, CUDA_0}},
@@ -87,5 +87,5 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_FFT_TYPE_NAME_VER_MAP {
   {"CUFFT_NOT_SUPPORTED",              {CUDA_80,  CUDA_0, CUDA_0}},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_FFT_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_FFT_TYPE_NAME_VER_MAP {
 };
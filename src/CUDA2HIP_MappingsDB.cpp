@@ -0,0 +1,212 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <fstream>
+#include <algorithm>
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Path.h"
+#include "CUDA2HIP.h"
+#include "CUDA2HIP_Scripting.h"
+#include "ArgParse.h"
+#include "StringUtils.h"
+#include "LLVMCompat.h"
+#include "MappingsDB.h"
+#include "MappingsTable.h"
+
+using namespace llvm;
+
+namespace mappingsdb {
+
+  struct mapping {
+    StringRef cudaName;
+    const hipCounter *counter;
+    cudaAPIversions cudaVersions;
+    hipAPIversions hipVersions;
+    mappingKind kind;
+  };
+
+  void addMappings(std::vector<mapping> &mappings, mappingKind kind, ArrayRef<MappingsTable::ID> ids) {
+    const MappingsTable &table = MappingsTable::get();
+    for (auto id : ids) {
+      mappings.push_back({table.getCudaName(id), &table.getCounter(id), table.getCudaVersions(id), table.getHipVersions(id), kind});
+    }
+  }
+
+  // The mappings of each kind are in the order of CUDA names, as the database expects them.
+  std::vector<mapping> getMappings() {
+    const MappingsTable &table = MappingsTable::get();
+    std::vector<mapping> ret;
+    addMappings(ret, MAPPING_RENAME, table.getRenames());
+    addMappings(ret, MAPPING_INCLUDE, table.getIDs(CUDA_INCLUDE_MAP));
+    addMappings(ret, MAPPING_DEVICE_FUNC, table.getIDs(CUDA_DEVICE_FUNC_MAP));
+    addMappings(ret, MAPPING_CUB, table.getIDs(CUDA_CUB_TYPE_NAME_MAP));
+    return ret;
+  }
+
+  class stringPool {
+  public:
+    stringPool() { add(""); }
+    uint32_t add(StringRef s) {
+      auto it = offsets.insert(std::make_pair(s, uint32_t(data.size())));
+      if (it.second) {
+        data.append(s.begin(), s.end());
+        data.push_back('\0');
+      }
+      return it.first->second;
+    }
+    StringRef str() const { return StringRef(data.data(), data.size()); }
+
+  private:
+    StringMap<uint32_t> offsets;
+    SmallString<65536> data;
+  };
+
+  template <typename T>
+  void write(std::ostream &out, const T &t) {
+    out.write(reinterpret_cast<const char*>(&t), sizeof(T));
+  }
+
+  void write(std::ostream &out, const std::vector<mapping> &mappings) {
+    stringPool strings;
+    std::vector<mappingsDBEntry> entries(mappings.size());
+    for (size_t i = 0; i < mappings.size(); ++i) {
+      const mapping &m = mappings[i];
+      mappingsDBEntry &e = entries[i];
+      e.cudaName = strings.add(m.cudaName);
+      e.cudaNameSize = m.cudaName.size();
+      e.hipName = strings.add(m.counter->hipName);
+      e.hipNameSize = m.counter->hipName.size();
+      e.rocName = strings.add(m.counter->rocName);
+      e.rocNameSize = m.counter->rocName.size();
+      e.kind = m.kind;
+      e.type = m.counter->type;
+      e.apiType = m.counter->apiType;
+      e.apiSection = m.counter->apiSection;
+      e.supportDegree = m.counter->supportDegree;
+      e.cudaAppeared = m.cudaVersions.appeared;
+      e.cudaDeprecated = m.cudaVersions.deprecated;
+      e.cudaRemoved = m.cudaVersions.removed;
+      e.hipAppeared = m.hipVersions.appeared;
+      e.hipDeprecated = m.hipVersions.deprecated;
+      e.hipRemoved = m.hipVersions.removed;
+    }
+    // Keep the load factor of the index at most 0.5.
+    const uint32_t bucketCount = NextPowerOf2(2 * mappings.size());
+    std::vector<uint32_le> buckets(bucketCount);
+    for (uint32_t i = 0; i < bucketCount; ++i) buckets[i] = 0;
+    for (size_t i = 0; i < mappings.size(); ++i) {
+      uint32_t b = MappingsDB::hash(mappings[i].cudaName) & (bucketCount - 1);
+      while (buckets[b] != 0) b = (b + 1) & (bucketCount - 1);
+      buckets[b] = i + 1;
+    }
+    mappingsDBHeader header;
+    std::copy(MappingsDB::Magic, MappingsDB::Magic + sizeof(MappingsDB::Magic), header.magic);
+    header.version = MappingsDB::Version;
+    header.entryCount = entries.size();
+    header.bucketCount = bucketCount;
+    header.entriesOffset = sizeof(mappingsDBHeader);
+    header.bucketsOffset = header.entriesOffset + entries.size() * sizeof(mappingsDBEntry);
+    header.stringsOffset = header.bucketsOffset + bucketCount * sizeof(uint32_le);
+    header.stringsSize = strings.str().size();
+    write(out, header);
+    for (auto &e : entries) write(out, e);
+    for (auto &b : buckets) write(out, b);
+    out.write(strings.str().data(), strings.str().size());
+  }
+
+  bool isSameMapping(const MappingsDB &db, const mappingsDBEntry &e, const mapping &m) {
+    const hipCounter counter = db.getCounter(e);
+    const cudaAPIversions cudaVer = db.getCudaVersions(e);
+    const hipAPIversions hipVer = db.getHipVersions(e);
+    return e.kind == uint32_t(m.kind) && db.getCudaName(e) == m.cudaName &&
+      counter.hipName == m.counter->hipName && counter.rocName == m.counter->rocName &&
+      counter.type == m.counter->type && counter.apiType == m.counter->apiType &&
+      counter.apiSection == m.counter->apiSection && counter.supportDegree == m.counter->supportDegree &&
+      cudaVer.appeared == m.cudaVersions.appeared && cudaVer.deprecated == m.cudaVersions.deprecated &&
+      cudaVer.removed == m.cudaVersions.removed && hipVer.appeared == m.hipVersions.appeared &&
+      hipVer.deprecated == m.hipVersions.deprecated && hipVer.removed == m.hipVersions.removed;
+  }
+
+  // Load the written database back and check that it returns exactly what was written: every entry in its place,
+  // with all its fields, and found by its CUDA name and kind through the hash index.
+  bool verify(StringRef path, const std::vector<mapping> &mappings) {
+    std::string error;
+    std::unique_ptr<MappingsDB> db = MappingsDB::open(path, error);
+    if (!db) {
+      llvm::errs() << "\n" << sHipify << sError << error << "\n";
+      return false;
+    }
+    if (db->size() != mappings.size()) {
+      llvm::errs() << "\n" << sHipify << sError << "wrong number of mappings in " << path << "\n";
+      return false;
+    }
+    for (uint32_t i = 0; i < db->size(); ++i) {
+      const mapping &m = mappings[i];
+      if (!isSameMapping(*db, (*db)[i], m) || db->find(m.cudaName, m.kind) != &(*db)[i]) {
+        llvm::errs() << "\n" << sHipify << sError << "wrong mapping of " << m.cudaName << " in " << path << "\n";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool generate(bool Generate) {
+    if (!Generate) {
+      return true;
+    }
+    std::string dstMappingsDB = MappingsDB::FileName, dstMappingsDBDir = OutputMappingsDBDir;
+    std::error_code EC;
+    if (!dstMappingsDBDir.empty()) {
+      std::string sOutputMappingsDBDirAbsPath = getAbsoluteDirectoryPath(OutputMappingsDBDir, EC, "output mappings database");
+      if (EC) {
+        return false;
+      }
+      dstMappingsDB = sOutputMappingsDBDirAbsPath + "/" + dstMappingsDB;
+    }
+    SmallString<128> tmpFile;
+    StringRef ext = "hipify-tmp";
+    EC = sys::fs::createTemporaryFile(dstMappingsDB, ext, tmpFile);
+    if (EC) {
+      llvm::errs() << "\n" << sHipify << sError << EC.message() << ": " << tmpFile << "\n";
+      return false;
+    }
+    const std::vector<mapping> mappings = getMappings();
+    {
+      std::ofstream out(tmpFile.c_str(), std::ios_base::trunc | std::ios_base::binary);
+      write(out, mappings);
+    }
+    bool ret = verify(tmpFile, mappings);
+    if (ret) {
+      EC = sys::fs::copy_file(tmpFile, dstMappingsDB);
+      if (EC) {
+        llvm::errs() << "\n" << sHipify << sError << EC.message() << ": while copying " << tmpFile << " to " << dstMappingsDB << "\n";
+        ret = false;
+      }
+    }
+    if (!SaveTemps) {
+      sys::fs::remove(tmpFile);
+    }
+    return ret;
+  }
+}
@@ -0,0 +1,156 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <deque>
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/StringSaver.h"
+#include "CUDA2HIP.h"
+#include "LLVMCompat.h"
+#include "MappingsDB.h"
+
+namespace {
+
+// All the loaded overlays: the entries point to the strings and counters kept here.
+struct overlayStorage {
+  std::vector<std::pair<llvm::StringRef, const hipCounter*>> entries;
+  std::deque<hipCounter> counters;
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> buffers;
+  std::vector<std::unique_ptr<MappingsDB>> databases;
+  bool used = false;
+};
+
+overlayStorage &overlay() {
+  static overlayStorage storage;
+  return storage;
+}
+
+bool parseEnum(llvm::StringRef s, const char **names, int count, int &value) {
+  for (int i = 0; i < count; ++i) {
+    if (s == names[i]) {
+      value = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parseSupportDegree(llvm::StringRef s, unsigned int &value) {
+  value = FULL;
+  llvm::SmallVector<llvm::StringRef, 4> flags;
+  s.split(flags, '|');
+  for (auto flag : flags) {
+    unsigned int f = llvm::StringSwitch<unsigned int>(flag)
+      .Case("FULL", FULL)
+      .Case("HIP_UNSUPPORTED", HIP_UNSUPPORTED)
+      .Case("ROC_UNSUPPORTED", ROC_UNSUPPORTED)
+      .Case("UNSUPPORTED", UNSUPPORTED)
+      .Case("DEPRECATED", DEPRECATED)
+      .Case("CUDA_DEPRECATED", CUDA_DEPRECATED)
+      .Case("HIP_DEPRECATED", HIP_DEPRECATED)
+      .Case("REMOVED", REMOVED)
+      .Case("CUDA_REMOVED", CUDA_REMOVED)
+      .Case("HIP_REMOVED", HIP_REMOVED)
+      .Default(~0u);
+    if (f == ~0u) {
+      return false;
+    }
+    value |= f;
+  }
+  return true;
+}
+
+bool loadDatabase(std::unique_ptr<llvm::MemoryBuffer> buffer) {
+  std::string error;
+  std::unique_ptr<MappingsDB> db = MappingsDB::create(std::move(buffer), error);
+  if (!db) {
+    llvm::errs() << "\n" << sHipify << sError << error << "\n";
+    return false;
+  }
+  overlayStorage &storage = overlay();
+  for (auto &e : *db) {
+    if (e.kind != MAPPING_RENAME) continue;
+    storage.counters.push_back(db->getCounter(e));
+    storage.entries.push_back({db->getCudaName(e), &storage.counters.back()});
+  }
+  storage.databases.push_back(std::move(db));
+  return true;
+}
+
+bool loadText(std::unique_ptr<llvm::MemoryBuffer> buffer) {
+  overlayStorage &storage = overlay();
+  llvm::StringRef path = buffer->getBufferIdentifier();
+  llvm::SmallVector<llvm::StringRef, 8> lines, tokens;
+  buffer->getBuffer().split(lines, '\n');
+  unsigned lineNumber = 0;
+  for (auto line : lines) {
+    ++lineNumber;
+    line = line.split('#').first.trim();
+    if (line.empty()) continue;
+    tokens.clear();
+    llvm::SplitString(line, tokens, " \t");
+    int type = 0, apiType = 0;
+    unsigned int supportDegree = FULL;
+    if (tokens.size() < 5 || tokens.size() > 6 ||
+        !parseEnum(tokens[3], counterTypes, NUM_CONV_TYPES, type) ||
+        !parseEnum(tokens[4], apiTypes, NUM_API_TYPES, apiType) ||
+        (tokens.size() == 6 && !parseSupportDegree(tokens[5], supportDegree))) {
+      llvm::errs() << "\n" << sHipify << sError << path << ":" << lineNumber << ": wrong mapping: expected "
+                   << "<CUDA name> <HIP name> <ROC name> <CONV_ type> <API_ type> [<support flags>]\n";
+      return false;
+    }
+    // "-" stands for an empty name.
+    llvm::StringRef hipName = tokens[1] == "-" ? "" : tokens[1];
+    llvm::StringRef rocName = tokens[2] == "-" ? "" : tokens[2];
+    storage.counters.push_back({hipName, rocName, ConvTypes(type), ApiTypes(apiType), 0, supportDegree});
+    storage.entries.push_back({tokens[0], &storage.counters.back()});
+  }
+  storage.buffers.push_back(std::move(buffer));
+  return true;
+}
+
+}
+
+bool loadMappingOverlay(llvm::StringRef path) {
+  if (overlay().used) {
+    llvm::errs() << "\n" << sHipify << sError << "mapping overlay " << path << " is loaded after the mappings are in use\n";
+    return false;
+  }
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    llvm::errs() << "\n" << sHipify << sError << buffer.getError().message() << ": " << path << "\n";
+    return false;
+  }
+  llvm::StringRef data = buffer.get()->getBuffer();
+  if (data.size() >= sizeof(MappingsDB::Magic) && std::memcmp(data.data(), MappingsDB::Magic, sizeof(MappingsDB::Magic)) == 0) {
+    return loadDatabase(std::move(buffer.get()));
+  }
+  return loadText(std::move(buffer.get()));
+}
+
+llvm::ArrayRef<std::pair<llvm::StringRef, const hipCounter*>> CUDA_RENAMES_OVERLAY() {
+  overlay().used = true;
+  return overlay().entries;
+}
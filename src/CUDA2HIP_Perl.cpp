@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "StringUtils.h"
 #include "LLVMCompat.h"
 #include "Statistics.h"
+#include "MappingsTable.h"
 
 namespace perl {
 
@@ -159,6 +160,7 @@ namespace perl {
     *streamPtr.get() << my << "$whitelist = \"\";" << endl;
     *streamPtr.get() << my << "$exclude_dirs =  \"\";" << endl;
     *streamPtr.get() << my << "$exclude_files = \"\";" << endl;
+    *streamPtr.get() << my << "$jobs = 1;" << endl;
     *streamPtr.get() << my << "$fileName = \"\";" << endl;
     *streamPtr.get() << my << "%ft;" << endl;
     *streamPtr.get() << my << "%Tkernels;" << endl_2;
@@ -171,6 +173,7 @@ namespace perl {
     *streamPtr.get() << tab << ", \"whitelist=s\" => \\$whitelist            # Whitelist of identifiers." << endl;
     *streamPtr.get() << tab << ", \"exclude-dirs=s\" => \\$exclude_dirs      # Exclude directories." << endl;
     *streamPtr.get() << tab << ", \"exclude-files=s\" => \\$exclude_files    # Exclude files." << endl;
+    *streamPtr.get() << tab << ", \"j=i\" => \\$jobs                         # Hipify the input files in N parallel worker processes; on a failure, unlike -j 1, the files being hipified by the other workers are still written." << endl;
     *streamPtr.get() << ");" << endl_2;
     *streamPtr.get() << "$print_stats = 1 if $examine;" << endl;
     *streamPtr.get() << "$no_output = 1 if $examine;" << endl_2;
@@ -183,6 +186,9 @@ namespace perl {
     }
     *streamPtr.get() << endl << ");" << endl_2;
     *streamPtr.get() << "push(@whitelist, split(',', $whitelist));" << endl;
+    *streamPtr.get() << "# A single regex matching any of the whitelisted words" << endl;
+    *streamPtr.get() << "$whitelistRegex = join('|', grep { $_ ne \"\" } @whitelist);" << endl;
+    *streamPtr.get() << "$whitelistRegex = qr/\\b(?:$whitelistRegex)\\b/;" << endl;
     *streamPtr.get() << "push(@exclude_dirlist, split(',', $exclude_dirs));" << endl;
     *streamPtr.get() << "push(@exclude_filelist, split(',', $exclude_files));" << endl_2;
     *streamPtr.get() << "# Turn exclude dirlist and exclude_filelist into hash maps" << endl;
@@ -219,28 +225,45 @@ namespace perl {
   }
 
   void generateSimpleSubstitutions(unique_ptr<ostream> &streamPtr) {
-    *streamPtr.get() << endl << sub << "simpleSubstitutions" << " {" << endl;
-    for (int i = 0; i < NUM_CONV_TYPES; ++i) {
-      if (i == CONV_INCLUDE_CUDA_MAIN_H || i == CONV_INCLUDE) {
-        for (auto &ma : CUDA_INCLUDE_MAP) {
-          if (Statistics::isUnsupported(ma.second)) continue;
-          if (i == ma.second.type) {
-            string sCUDA = ma.first.str();
-            string sHIP = ma.second.hipName.str();
-            sCUDA = regex_replace(sCUDA, regex("/"), "\\/");
-            sHIP = regex_replace(sHIP, regex("/"), "\\/");
-            *streamPtr.get() << tab << "$ft{'" << counterNames[ma.second.type] << "'} += s/\\b" << sCUDA << "\\b/" << sHIP << "/g;" << endl;
-          }
+    // CUDA identifiers are replaced in a single pass by a regex, matching any of them, and a hash lookup for the
+    // replacement, instead of a substitution per mapping. Perl compiles such an alternation into a trie, so the cost
+    // per line doesn't depend on the number of mappings. The identifiers of the types before the include types are
+    // replaced before the includes, and the rest after them, as if all of them were substituted in the order of types.
+    const MappingsTable &table = MappingsTable::get();
+    const string substitutions[2] = {"early", "late"};
+    for (int i = 0; i < 2; ++i) {
+      *streamPtr.get() << endl << "# CUDA identifiers to replace " << (i ? "after" : "before") << " includes: [statistics counter, HIP identifier]" << endl;
+      *streamPtr.get() << "%" << substitutions[i] << "Substitutions = (" << endl;
+      for (int j = i ? CONV_INCLUDE_CUDA_MAIN_H + 1 : 0; j < (i ? NUM_CONV_TYPES : CONV_INCLUDE); ++j) {
+        for (auto id : table.getRenames(ConvTypes(j))) {
+          const hipCounter &counter = table.getCounter(id);
+          if (Statistics::isUnsupported(counter)) continue;
+          *streamPtr.get() << tab << "'" << table.getCudaName(id).str() << "' => ['" << counterNames[counter.type] << "', '" << counter.hipName.str() << "']," << endl;
         }
-      } else {
-        for (auto &ma : CUDA_RENAMES_MAP()) {
-          if (Statistics::isUnsupported(ma.second)) continue;
-          if (i == ma.second.type) {
-            *streamPtr.get() << tab << "$ft{'" << counterNames[ma.second.type] << "'} += s/\\b" << ma.first.str() << "\\b/" << ma.second.hipName.str() << "/g;" << endl;
-          }
+      }
+      *streamPtr.get() << ");" << endl;
+      *streamPtr.get() << "$" << substitutions[i] << "Regex = join('|', sort keys %" << substitutions[i] << "Substitutions);" << endl;
+      *streamPtr.get() << "$" << substitutions[i] << "Regex = qr/\\b($" << substitutions[i] << "Regex)\\b/;" << endl;
+    }
+    *streamPtr.get() << endl << sub << "substituteIdentifiers" << " {" << endl;
+    *streamPtr.get() << tab << my << "$substitutions = shift();" << endl;
+    *streamPtr.get() << tab << my << "$regex = shift();" << endl;
+    *streamPtr.get() << tab << "s/$regex/$ft{$substitutions->{$1}->[0]}++; $substitutions->{$1}->[1]/ge if %$substitutions;" << endl << "}" << endl;
+    *streamPtr.get() << endl << sub << "simpleSubstitutions" << " {" << endl;
+    *streamPtr.get() << tab << "substituteIdentifiers(\\%" << substitutions[0] << "Substitutions, $" << substitutions[0] << "Regex);" << endl;
+    for (int i = CONV_INCLUDE; i <= CONV_INCLUDE_CUDA_MAIN_H; ++i) {
+      for (auto &ma : CUDA_INCLUDE_MAP) {
+        if (Statistics::isUnsupported(ma.second)) continue;
+        if (i == ma.second.type) {
+          string sCUDA = ma.first.str();
+          string sHIP = ma.second.hipName.str();
+          sCUDA = regex_replace(sCUDA, regex("/"), "\\/");
+          sHIP = regex_replace(sHIP, regex("/"), "\\/");
+          *streamPtr.get() << tab << "$ft{'" << counterNames[ma.second.type] << "'} += s/\\b" << sCUDA << "\\b/" << sHIP << "/g;" << endl;
         }
       }
     }
+    *streamPtr.get() << tab << "substituteIdentifiers(\\%" << substitutions[1] << "Substitutions, $" << substitutions[1] << "Regex);" << endl;
     *streamPtr.get() << "}" << endl;
   }
 
@@ -254,44 +277,99 @@ namespace perl {
   }
 
   void generateKernelLaunch(unique_ptr<ostream> &streamPtr) {
-    *streamPtr.get() << endl << "# CUDA Kernel Launch Syntax" << endl << sub << "transformKernelLaunch" << " {" << endl;
-    *streamPtr.get() << tab << no_warns << endl;
-    *streamPtr.get() << tab << my_k << endl_2;
-
-    string s_k = "$k += s/([:|\\w]+)\\s*";
-    *streamPtr.get() << tab << "# Handle the kern<...><<<Dg, Db, Ns, S>>>() syntax with empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<(.+)>\\s*<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\((\\s*)\\)/hipLaunchKernelGGL(HIP_KERNEL_NAME($1<$2>), dim3($3), dim3($4), $5, $6)/g;" << endl;
-    *streamPtr.get() << tab << "# Handle the kern<<<Dg, Db, Ns, S>>>() syntax with empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\((\\s*)\\)/hipLaunchKernelGGL($1, dim3($2), dim3($3), $4, $5)/g;" << endl_2;
-
-    *streamPtr.get() << tab << "# Handle the kern<...><<<Dg, Db, Ns, S>>>(...) syntax with non-empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<(.+)>\\s*<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\(/hipLaunchKernelGGL(HIP_KERNEL_NAME($1<$2>), dim3($3), dim3($4), $5, $6, /g;" << endl;
-    *streamPtr.get() << tab << "# Handle the kern<<<Dg, Db, Ns, S>>>(...) syntax with non-empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\(/hipLaunchKernelGGL($1, dim3($2), dim3($3), $4, $5, /g;" << endl_2;
-
-    *streamPtr.get() << tab << "# Handle the kern<...><<<Dg, Db, Ns>>>() syntax with empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<(.+)>\\s*<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\((\\s*)\\)/hipLaunchKernelGGL(HIP_KERNEL_NAME($1<$2>), dim3($3), dim3($4), $5, 0)/g;" << endl;
-    *streamPtr.get() << tab << "# Handle the kern<<<Dg, Db, Ns>>>() syntax with empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\((\\s*)\\)/hipLaunchKernelGGL($1, dim3($2), dim3($3), $4, 0)/g;" << endl_2;
-
-    *streamPtr.get() << tab << "# Handle the kern<...><<Dg, Db, Ns>>>(...) syntax with non-empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<(.+)>\\s*<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\(/hipLaunchKernelGGL(HIP_KERNEL_NAME($1<$2>), dim3($3), dim3($4), $5, 0, /g;" << endl;
-    *streamPtr.get() << tab << "# Handle the kern<<<Dg, Db, Ns>>>(...) syntax with non-empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<<<\\s*(.+)\\s*,\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\(/hipLaunchKernelGGL($1, dim3($2), dim3($3), $4, 0, /g;" << endl_2;
-
-    *streamPtr.get() << tab << "# Handle the kern<...><<<Dg, Db>>>() syntax with empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<(.+)>\\s*<<<\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\((\\s*)\\)/hipLaunchKernelGGL(HIP_KERNEL_NAME($1<$2>), dim3($3), dim3($4), 0, 0)/g;" << endl;
-    *streamPtr.get() << tab << "# Handle the kern<<<Dg, Db>>>() syntax with empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<<<\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\((\\s*)\\)/hipLaunchKernelGGL($1, dim3($2), dim3($3), 0, 0)/g;" << endl_2;
-
-    *streamPtr.get() << tab << "# Handle the kern<...><<<Dg, Db>>>(...) syntax with non-empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<(.+)>\\s*<<<\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\(/hipLaunchKernelGGL(HIP_KERNEL_NAME($1<$2>), dim3($3), dim3($4), 0, 0, /g;" << endl;
-    *streamPtr.get() << tab << "# Handle the kern<<<Dg, Db>>>(...) syntax with non-empty args:" << endl;
-    *streamPtr.get() << tab << s_k << "<<<\\s*(.+)\\s*,\\s*(.+)\\s*>>>(\\s*)\\(/hipLaunchKernelGGL($1, dim3($2), dim3($3), 0, 0, /g;" << endl_2;
-
+    // Instead of a cascade of regexes with greedy groups per launch arity, the kernel launches are found by <<< and parsed
+    // by a scanner, which balances the brackets of the launch configuration: the commas of dim3(x, y) do not split it.
+    *streamPtr.get() << endl << "# CUDA Kernel Launch Syntax" << endl;
+    *streamPtr.get() << "# Replace every kern<...><<<Dg, Db[, Ns[, S]]>>>(...) launch in $_ with hipLaunchKernelGGL in a single scan, splitting" << endl;
+    *streamPtr.get() << "# the launch configuration at the commas, which are outside of brackets and literals, so that it might span lines" << endl;
+    *streamPtr.get() << sub << "transformKernelLaunch" << " {" << endl;
+    *streamPtr.get() << tab << my_k << endl;
+    *streamPtr.get() << tab << my << "$result = \"\";" << endl;
+    *streamPtr.get() << tab << my << "$done = 0;" << endl;
+    *streamPtr.get() << tab << my << "$start = 0;" << endl;
+    *streamPtr.get() << tab << while_ << "(($start = index($_, \"<<<\", $start)) >= 0) {" << endl;
+    *streamPtr.get() << tab_2 << my << "$launch = transformKernelLaunchAt($start, $done);" << endl;
+    *streamPtr.get() << tab_2 << "if (!defined $launch) {" << endl;
+    *streamPtr.get() << tab_3 << "$start += 3;" << endl;
+    *streamPtr.get() << tab_3 << "next;" << endl;
+    *streamPtr.get() << tab_2 << "}" << endl;
+    *streamPtr.get() << tab_2 << "$result .= substr($_, $done, $launch->[1] - $done) . $launch->[2];" << endl;
+    *streamPtr.get() << tab_2 << "$done = $start = $launch->[3];" << endl;
+    *streamPtr.get() << tab_2 << "$Tkernels{$launch->[0]}++;" << endl;
+    *streamPtr.get() << tab_2 << "$k++;" << endl;
+    *streamPtr.get() << tab << "}" << endl;
     *streamPtr.get() << tab << "if ($k) {" << endl;
+    *streamPtr.get() << tab_2 << "$_ = $result . substr($_, $done);" << endl;
     *streamPtr.get() << tab_2 << "$ft{'kernel_launch'} += $k;" << endl;
-    *streamPtr.get() << tab_2 << "$Tkernels{$1}++;" << endl_tab << "}" << endl << "}" << endl;
+    *streamPtr.get() << tab << "}" << endl;
+    *streamPtr.get() << "}" << endl;
+    *streamPtr.get() << endl << "# Parse the kernel launch, whose <<< is at the given offset of $_ after the already transformed part of it: return" << endl;
+    *streamPtr.get() << "# the kernel name, its offset, the launch with hipLaunchKernelGGL and the offset after the opening parenthesis of" << endl;
+    *streamPtr.get() << "# the args, or undef if it is not a kernel launch" << endl;
+    *streamPtr.get() << sub << "transformKernelLaunchAt" << " {" << endl;
+    *streamPtr.get() << tab << my << "$start = shift();" << endl;
+    *streamPtr.get() << tab << my << "$done = shift();" << endl;
+    *streamPtr.get() << tab << "# The kernel name with the optional template args, which end right before <<<" << endl;
+    *streamPtr.get() << tab << my << "$begin = $start;" << endl;
+    *streamPtr.get() << tab << "$begin-- while ($begin > 0 and substr($_, $begin - 1, 1) =~ /\\s/);" << endl;
+    *streamPtr.get() << tab << my << "$templateEnd = $begin;" << endl;
+    *streamPtr.get() << tab << "if ($begin > 0 and substr($_, $begin - 1, 1) eq '>') {" << endl;
+    *streamPtr.get() << tab_2 << my << "$depth = 0;" << endl;
+    *streamPtr.get() << tab_2 << while_ << "($begin > 0) {" << endl;
+    *streamPtr.get() << tab_3 << my << "$c = substr($_, --$begin, 1);" << endl;
+    *streamPtr.get() << tab_3 << "return undef if $begin < $done;" << endl;
+    *streamPtr.get() << tab_3 << "if ($c eq '>' or $c eq ')') {" << endl;
+    *streamPtr.get() << tab_4 << "$depth++;" << endl;
+    *streamPtr.get() << tab_3 << "} elsif ($c eq '<' or $c eq '(') {" << endl;
+    *streamPtr.get() << tab_4 << "last if --$depth == 0;" << endl;
+    *streamPtr.get() << tab_3 << "}" << endl;
+    *streamPtr.get() << tab_2 << "}" << endl;
+    *streamPtr.get() << tab_2 << "return undef if $depth;" << endl;
+    *streamPtr.get() << tab_2 << "$begin-- while ($begin > 0 and substr($_, $begin - 1, 1) =~ /\\s/);" << endl;
+    *streamPtr.get() << tab << "}" << endl;
+    *streamPtr.get() << tab << my << "$templateBegin = $begin;" << endl;
+    *streamPtr.get() << tab << "$begin-- while ($begin > 0 and substr($_, $begin - 1, 1) =~ /[:\\w]/);" << endl;
+    *streamPtr.get() << tab << "return undef if $begin == $templateBegin;" << endl;
+    *streamPtr.get() << tab << my << "$name = substr($_, $begin, $templateBegin - $begin);" << endl;
+    *streamPtr.get() << tab << my << "$kernel = $name;" << endl;
+    *streamPtr.get() << tab << "if ($templateBegin != $templateEnd) {" << endl;
+    *streamPtr.get() << tab_2 << my << "$template = substr($_, $templateBegin + 1, $templateEnd - $templateBegin - 2);" << endl;
+    *streamPtr.get() << tab_2 << "$kernel = \"HIP_KERNEL_NAME($kernel<$template>)\";" << endl;
+    *streamPtr.get() << tab << "}" << endl;
+    *streamPtr.get() << tab << "# The launch configuration, split at the top level commas, up to >>>" << endl;
+    *streamPtr.get() << tab << my << "@config = (\"\");" << endl;
+    *streamPtr.get() << tab << my << "$depth = 0;" << endl;
+    *streamPtr.get() << tab << "pos() = $start + 3;" << endl;
+    *streamPtr.get() << tab << while_ << "(1) {" << endl;
+    *streamPtr.get() << tab_2 << "if (/\\G([^()\\[\\]{},>\"']+)/gc) {" << endl;
+    *streamPtr.get() << tab_3 << "$config[-1] .= $1;" << endl;
+    *streamPtr.get() << tab_2 << "} elsif (/\\G(\"(?:[^\"\\\\\\n]|\\\\.)*\"|'(?:[^'\\\\\\n]|\\\\.)*')/gc) {" << endl;
+    *streamPtr.get() << tab_3 << "$config[-1] .= $1;" << endl;
+    *streamPtr.get() << tab_2 << "} elsif (/\\G([(\\[{])/gc) {" << endl;
+    *streamPtr.get() << tab_3 << "$depth++;" << endl;
+    *streamPtr.get() << tab_3 << "$config[-1] .= $1;" << endl;
+    *streamPtr.get() << tab_2 << "} elsif (/\\G([)\\]}])/gc) {" << endl;
+    *streamPtr.get() << tab_3 << "return undef if $depth-- == 0;" << endl;
+    *streamPtr.get() << tab_3 << "$config[-1] .= $1;" << endl;
+    *streamPtr.get() << tab_2 << "} elsif ($depth == 0 and /\\G,/gc) {" << endl;
+    *streamPtr.get() << tab_3 << "push @config, \"\";" << endl;
+    *streamPtr.get() << tab_2 << "} elsif ($depth == 0 and /\\G>>>/gc) {" << endl;
+    *streamPtr.get() << tab_3 << "last;" << endl;
+    *streamPtr.get() << tab_2 << "} elsif (/\\G(.)/gcs) {" << endl;
+    *streamPtr.get() << tab_3 << "$config[-1] .= $1;" << endl;
+    *streamPtr.get() << tab_2 << "} else {" << endl;
+    *streamPtr.get() << tab_3 << "return undef;" << endl;
+    *streamPtr.get() << tab_2 << "}" << endl;
+    *streamPtr.get() << tab << "}" << endl;
+    *streamPtr.get() << tab << "return undef if @config < 2 or @config > 4;" << endl;
+    *streamPtr.get() << tab << "s/^\\s+|\\s+$//g foreach @config;" << endl;
+    *streamPtr.get() << tab << "return undef if grep { $_ eq \"\" } @config;" << endl;
+    *streamPtr.get() << tab << "# The args: empty ones are closed right away" << endl;
+    *streamPtr.get() << tab << "return undef unless /\\G\\s*\\(/gc;" << endl;
+    *streamPtr.get() << tab << my << "$args = /\\G\\s*\\)/gc ? \")\" : \", \";" << endl;
+    *streamPtr.get() << tab << "push @config, \"0\" while @config < 4;" << endl;
+    *streamPtr.get() << tab << "return [$name, $begin, \"hipLaunchKernelGGL($kernel, dim3($config[0]), dim3($config[1]), $config[2], $config[3]$args\", pos()];" << endl;
+    *streamPtr.get() << "}" << endl;
   }
 
   void generateCubNamespace(unique_ptr<ostream> &streamPtr) {
@@ -334,79 +412,168 @@ namespace perl {
     *streamPtr.get() << tab << return_k << "}" << endl;
   }
 
+  void generateFunctionsLookup(unique_ptr<ostream> &streamPtr) {
+    // The warning and device function passes look up only the functions, which occur in $_, instead of matching every
+    // function of the list: findFunctions finds all of them in a single scan with a regex matching any of them, which
+    // Perl compiles into a trie. As the longest function is matched at every position, the functions, which are its
+    // prefixes, are added to the found ones as well.
+    *streamPtr.get() << endl << "# Index the list of functions for findFunctions: a regex, matching any of them, the longest first, and" << endl;
+    *streamPtr.get() << "# a hash of every function to the indices of the functions, which are its prefixes, itself included" << endl;
+    *streamPtr.get() << sub << "indexFunctions" << " {" << endl;
+    *streamPtr.get() << tab << my << "$functions = shift();" << endl;
+    *streamPtr.get() << tab << my << "%index;" << endl;
+    *streamPtr.get() << tab << "@index{@$functions} = (0 .. $#$functions);" << endl;
+    *streamPtr.get() << tab << my << "%prefixes;" << endl;
+    *streamPtr.get() << tab << foreach << my << "$func (@$functions) {" << endl;
+    *streamPtr.get() << tab_2 << "$prefixes{$func} = [grep { defined } map { $index{substr($func, 0, $_)} } (1 .. length($func))];" << endl_tab << "}" << endl;
+    *streamPtr.get() << tab << my << "$regex = join('|', sort { length($b) <=> length($a) } @$functions);" << endl;
+    *streamPtr.get() << tab << "return (qr/(?=($regex))/, \\%prefixes);" << endl << "}" << endl;
+    *streamPtr.get() << endl << "# Get the sorted indices of the functions of an indexed list, which occur in $_, keeping pos() of $_" << endl;
+    *streamPtr.get() << sub << "findFunctions" << " {" << endl;
+    *streamPtr.get() << tab << my << "$regex = shift();" << endl;
+    *streamPtr.get() << tab << my << "$prefixes = shift();" << endl;
+    *streamPtr.get() << tab << my << "$pos = pos();" << endl;
+    *streamPtr.get() << tab << my << "%found;" << endl;
+    *streamPtr.get() << tab << while_ << "(/$regex/g) {" << endl;
+    *streamPtr.get() << tab_2 << "@found{@{$prefixes->{$1}}} = ();" << endl_tab << "}" << endl;
+    *streamPtr.get() << tab << "pos() = $pos;" << endl;
+    *streamPtr.get() << tab << "return sort { $a <=> $b } keys %found;" << endl << "}" << endl;
+  }
+
+  // Generate the list of functions and its index for findFunctions.
+  void generateFunctions(unique_ptr<ostream> &streamPtr, const string &name, const vector<string> &functions) {
+    *streamPtr.get() << endl << "@" << name << " = (";
+    for (size_t i = 0; i < functions.size(); ++i) {
+      *streamPtr.get() << (i ? ",\n" : "\n") << tab << "\"" << functions[i] << "\"";
+    }
+    *streamPtr.get() << endl << ");" << endl;
+    *streamPtr.get() << "($" << name << "Regex, $" << name << "Prefixes) = indexFunctions(\\@" << name << ");" << endl;
+  }
+
+  // Generate a sub, which runs the match code for every function of the list, which occurs in $_, in the order of the list.
+  // Every scalar m//g match, failed for a function not occurring in $_, would reset pos() of $_ for the next match; so does
+  // the sub, keeping the warnings and counts the same as of matching all the functions in turn.
+  void generateFunctionsSub(unique_ptr<ostream> &streamPtr, const string &subName, const string &name, bool bLineNum, const string &match) {
+    *streamPtr.get() << endl << sub << subName << " {" << endl;
+    if (bLineNum) *streamPtr.get() << tab << my << "$line_num = shift;" << endl;
+    *streamPtr.get() << tab << my_k << endl;
+    *streamPtr.get() << tab << my << "$last = -1;" << endl;
+    *streamPtr.get() << tab << foreach << my << "$i (findFunctions($" << name << "Regex, $" << name << "Prefixes)) {" << endl;
+    *streamPtr.get() << tab_2 << "pos() = undef if $i != $last + 1;" << endl;
+    *streamPtr.get() << tab_2 << "$func = $" << name << "[$i];" << endl;
+    *streamPtr.get() << match;
+    *streamPtr.get() << tab_2 << "$last = $i;" << endl_tab << "}" << endl;
+    *streamPtr.get() << tab << "pos() = undef if $last != $#" << name << ";" << endl;
+    *streamPtr.get() << tab << return_k << "}" << endl;
+  }
+
   void generateDeprecatedAndUnsupportedFunctions(unique_ptr<ostream> &streamPtr) {
-    stringstream sDeprecated, sUnsupported, sCommon;
-    sCommon << tab << my << "$line_num = shift;" << endl;
-    sCommon << tab << my_k << "\n" << tab << foreach_func;
-    sDeprecated << endl << sub << "warnDeprecatedFunctions" << " {" << endl << sCommon.str();
-    sUnsupported << endl << sub << "warnUnsupportedFunctions" << " {" << endl << sCommon.str();
-    unsigned int countDeprecated = 0, countUnsupported = 0;
+    vector<string> deprecated, unsupported;
     for (auto ma = CUDA_RENAMES_MAP().rbegin(); ma != CUDA_RENAMES_MAP().rend(); ++ma) {
-        if (Statistics::isDeprecated(ma->second)) {
-            sDeprecated << (countDeprecated ? ",\n" : "") << tab_2 << "\"" << ma->first.str() << "\"";
-            countDeprecated++;
-        }
-        if (Statistics::isUnsupported(ma->second)) {
-            sUnsupported << (countUnsupported ? ",\n" : "") << tab_2 << "\"" << ma->first.str() << "\"";
-            countUnsupported++;
-        }
+      if (Statistics::isDeprecated(*ma->second)) deprecated.push_back(ma->first.str());
+      if (Statistics::isUnsupported(*ma->second)) unsupported.push_back(ma->first.str());
     }
-    sCommon.str(std::string());
-    sCommon << endl_tab << ")" << endl;
-    sCommon << tab << "{" << endl;
+    generateFunctions(streamPtr, "deprecatedFunctions", deprecated);
+    generateFunctions(streamPtr, "unsupportedFunctions", unsupported);
+    stringstream sCommon;
     sCommon << tab_2 << my << "$mt = m/($func)/g;" << endl;
     sCommon << tab_2 << "if ($mt) {" << endl;
     sCommon << tab_3 << "$k += $mt;" << endl;
-    sDeprecated << sCommon.str();
-    sUnsupported << sCommon.str();
-    sCommon.str(std::string());
-    sCommon << tab_2 << "}\n" << tab << "}\n" << tab << return_k << "}" << endl;
-    sDeprecated << tab_3 << print << "\"  "  << warning << "deprecated identifier \\\"$func\\\": $_\\n\";" << endl << sCommon.str();
-    sUnsupported << tab_3 << print << "\"  "  << warning << "unsupported identifier \\\"$func\\\": $_\\n\";" << endl << sCommon.str();
-    *streamPtr.get() << sDeprecated.str();
-    *streamPtr.get() << sUnsupported.str();
+    stringstream sDeprecated, sUnsupported;
+    sDeprecated << sCommon.str() << tab_3 << print << "\"  "  << warning << "deprecated identifier \\\"$func\\\": $_\\n\";" << endl_tab_2 << "}" << endl;
+    sUnsupported << sCommon.str() << tab_3 << print << "\"  "  << warning << "unsupported identifier \\\"$func\\\": $_\\n\";" << endl_tab_2 << "}" << endl;
+    generateFunctionsSub(streamPtr, "warnDeprecatedFunctions", "deprecatedFunctions", true, sDeprecated.str());
+    generateFunctionsSub(streamPtr, "warnUnsupportedFunctions", "unsupportedFunctions", true, sUnsupported.str());
   }
 
   void generateDeviceFunctions(unique_ptr<ostream> &streamPtr) {
-    unsigned int countUnsupported = 0;
-    unsigned int countSupported = 0;
-    stringstream sSupported;
-    stringstream sUnsupported;
+    vector<string> supported, unsupported;
     for (auto ma = CUDA_DEVICE_FUNC_MAP.rbegin(); ma != CUDA_DEVICE_FUNC_MAP.rend(); ++ma) {
-      bool isUnsupported = Statistics::isUnsupported(ma->second);
-      (isUnsupported ? sUnsupported : sSupported) << ((isUnsupported && countUnsupported) || (!isUnsupported && countSupported) ? ",\n" : "") << tab_2 << "\"" << ma->first.str() << "\"";
-      if (isUnsupported) countUnsupported++;
-      else countSupported++;
+      (Statistics::isUnsupported(ma->second) ? unsupported : supported).push_back(ma->first.str());
     }
-    stringstream subCountSupported;
-    stringstream subWarnUnsupported;
-    stringstream subCommon;
-    string sCommon = tab + my_k + "\n" + tab + foreach_func;
-    subCountSupported << endl << sub << "countSupportedDeviceFunctions" << " {" << endl << (countSupported ? sCommon : tab + return_0);
-    subWarnUnsupported << endl << sub << "warnUnsupportedDeviceFunctions" << " {" << endl << (countUnsupported ? tab + my + "$line_num = shift;\n" + sCommon : tab + return_0);
-    if (countSupported) subCountSupported << sSupported.str() << endl_tab << ")" << endl;
-    if (countUnsupported) subWarnUnsupported << sUnsupported.str() << endl_tab << ")" << endl;
-    if (countSupported || countUnsupported) {
-      subCommon << tab << "{" << endl;
-      subCommon << tab_2 << "# match device function from the list, except those, which have a namespace prefix (aka somenamespace::umin(...));" << endl;
-      subCommon << tab_2 << "# function with only global namespace qualifier '::' (aka ::umin(...)) should be treated as a device function (and warned as well as without such qualifier);" << endl;
-      subCommon << tab_2 << my << "$mt_namespace = m/(\\w+)::($func)\\s*\\(\\s*.*\\s*\\)/g;" << endl;
-      subCommon << tab_2 << my << "$mt = m/($func)\\s*\\(\\s*.*\\s*\\)/g;" << endl;
-      subCommon << tab_2 << "if ($mt && !$mt_namespace) {" << endl;
-      subCommon << tab_3 << "$k += $mt;" << endl;
+    stringstream sCommon;
+    sCommon << tab_2 << "# match device function from the list, except those, which have a namespace prefix (aka somenamespace::umin(...));" << endl;
+    sCommon << tab_2 << "# function with only global namespace qualifier '::' (aka ::umin(...)) should be treated as a device function (and warned as well as without such qualifier);" << endl;
+    sCommon << tab_2 << my << "$mt_namespace = m/(\\w+)::($func)\\s*\\(\\s*.*\\s*\\)/g;" << endl;
+    sCommon << tab_2 << my << "$mt = m/($func)\\s*\\(\\s*.*\\s*\\)/g;" << endl;
+    sCommon << tab_2 << "if ($mt && !$mt_namespace) {" << endl;
+    sCommon << tab_3 << "$k += $mt;" << endl;
+    if (supported.empty()) {
+      *streamPtr.get() << endl << sub << "countSupportedDeviceFunctions" << " {" << endl << tab << return_0 << "}" << endl;
+    } else {
+      generateFunctions(streamPtr, "supportedDeviceFunctions", supported);
+      generateFunctionsSub(streamPtr, "countSupportedDeviceFunctions", "supportedDeviceFunctions", false, sCommon.str() + tab_2 + "}\n");
     }
-    if (countSupported) subCountSupported << subCommon.str();
-    if (countUnsupported) {
-      subWarnUnsupported << subCommon.str();
-      subWarnUnsupported << tab_3 << print << "\"  " << warning << "unsupported device function \\\"$func\\\": $_\\n\";" << endl;
+    if (unsupported.empty()) {
+      *streamPtr.get() << endl << sub << "warnUnsupportedDeviceFunctions" << " {" << endl << tab << return_0 << "}" << endl;
+    } else {
+      stringstream sUnsupported;
+      sUnsupported << sCommon.str() << tab_3 << print << "\"  " << warning << "unsupported device function \\\"$func\\\": $_\\n\";" << endl_tab_2 << "}" << endl;
+      generateFunctions(streamPtr, "unsupportedDeviceFunctions", unsupported);
+      generateFunctionsSub(streamPtr, "warnUnsupportedDeviceFunctions", "unsupportedDeviceFunctions", true, sUnsupported.str());
     }
-    if (countSupported || countUnsupported) sCommon = tab_2 + "}\n" + tab + "}\n" + tab + return_k;
-    if (countSupported) subCountSupported << sCommon;
-    if (countUnsupported) subWarnUnsupported << sCommon;
-    subCountSupported << "}" << endl;
-    subWarnUnsupported << "}" << endl;
-    *streamPtr.get() << subCountSupported.str();
-    *streamPtr.get() << subWarnUnsupported.str();
+  }
+
+  void generateParallel(unique_ptr<ostream> &streamPtr) {
+    // Every worker process hipifies every $jobs-th file with its own stdout, stderr and totals, so that merging them in
+    // the order of the files gives exactly the output and statistics of hipifying the files one by one.
+    *streamPtr.get() << endl << "# Hipify the files in $jobs worker processes, each hipifying every $jobs-th file into its output, warnings and" << endl;
+    *streamPtr.get() << "# statistics in a temporary directory; then print and add them up in the order of the files, as hipifying one by one" << endl;
+    *streamPtr.get() << sub << "hipifyFilesInParallel" << " {" << endl;
+    *streamPtr.get() << tab << "require File::Temp;" << endl;
+    *streamPtr.get() << tab << "require File::Path;" << endl;
+    *streamPtr.get() << tab << "require Storable;" << endl;
+    *streamPtr.get() << tab << my << "@files = @ARGV;" << endl;
+    *streamPtr.get() << tab << "@ARGV = ();" << endl;
+    *streamPtr.get() << tab << my << "$dir = File::Temp::tempdir(\"" << hipify_perl << "-XXXXXX\", TMPDIR => 1);" << endl;
+    *streamPtr.get() << tab << my << "@pids;" << endl;
+    *streamPtr.get() << tab << foreach << my << "$job (0 .. $jobs - 1) {" << endl;
+    *streamPtr.get() << tab_2 << my << "$pid = fork();" << endl;
+    *streamPtr.get() << tab_2 << "die \"error: could not fork\" unless defined $pid;" << endl;
+    *streamPtr.get() << tab_2 << "if ($pid) {" << endl;
+    *streamPtr.get() << tab_3 << "push(@pids, $pid);" << endl;
+    *streamPtr.get() << tab_3 << "next;" << endl_tab_2 << "}" << endl;
+    *streamPtr.get() << tab_2 << "for (my $i = $job; $i < @files; $i += $jobs) {" << endl;
+    *streamPtr.get() << tab_3 << "# Another worker failed on a file: stop, as hipifying one by one would; the files already being hipified by" << endl;
+    *streamPtr.get() << tab_3 << "# the other workers are still written" << endl;
+    *streamPtr.get() << tab_3 << "last if -e \"$dir/failed\";" << endl;
+    *streamPtr.get() << tab_3 << "open(STDOUT, \">\", \"$dir/$i.out\") or die \"error: could not open $dir/$i.out\";" << endl;
+    *streamPtr.get() << tab_3 << "open(STDERR, \">\", \"$dir/$i.err\") or die \"error: could not open $dir/$i.err\";" << endl;
+    *streamPtr.get() << tab_3 << "# Totals for this file only" << endl;
+    *streamPtr.get() << tab_3 << "clearStats(\\%tt, \\@statNames);" << endl;
+    *streamPtr.get() << tab_3 << "$Twarnings = 0;" << endl;
+    *streamPtr.get() << tab_3 << "$TlineCount = 0;" << endl;
+    *streamPtr.get() << tab_3 << "%TwarningTags = ();" << endl;
+    *streamPtr.get() << tab_3 << "%Tkernels = ();" << endl;
+    *streamPtr.get() << tab_3 << "%convertedTags = ();" << endl;
+    *streamPtr.get() << tab_3 << unless_ << "(eval { hipifyFile($files[$i]); 1 }) {" << endl;
+    *streamPtr.get() << tab_4 << "print STDERR $@;" << endl;
+    *streamPtr.get() << tab_4 << "open(my $failed, \">\", \"$dir/failed\");" << endl;
+    *streamPtr.get() << tab_4 << "close($failed);" << endl;
+    *streamPtr.get() << tab_4 << "exit(255);" << endl_tab_3 << "}" << endl;
+    *streamPtr.get() << tab_3 << "Storable::store([\\%tt, $Twarnings, $TlineCount, \\%TwarningTags, \\%Tkernels, \\%convertedTags], \"$dir/$i.stats\");" << endl_tab_2 << "}" << endl;
+    *streamPtr.get() << tab_2 << "close(STDOUT);" << endl;
+    *streamPtr.get() << tab_2 << "close(STDERR);" << endl;
+    *streamPtr.get() << tab_2 << "exit(0);" << endl_tab << "}" << endl;
+    *streamPtr.get() << tab << "waitpid($_, 0) foreach @pids;" << endl;
+    *streamPtr.get() << tab << "local $/;" << endl;
+    *streamPtr.get() << tab << foreach << my << "$i (0 .. $#files) {" << endl;
+    *streamPtr.get() << tab_2 << foreach << my << "$output ([\"out\", *STDOUT], [\"err\", *STDERR]) {" << endl;
+    *streamPtr.get() << tab_3 << "if (open(my $in, \"<\", \"$dir/$i.$output->[0]\")) {" << endl;
+    *streamPtr.get() << tab_4 << "print {$output->[1]} <$in>;" << endl;
+    *streamPtr.get() << tab_4 << "close($in);" << endl_tab_3 << "}" << endl_tab_2 << "}" << endl;
+    *streamPtr.get() << tab_2 << "# No statistics: the worker died on this file, as hipifying one by one would" << endl;
+    *streamPtr.get() << tab_2 << unless_ << "(-e \"$dir/$i.stats\") {" << endl;
+    *streamPtr.get() << tab_3 << "File::Path::rmtree($dir);" << endl;
+    *streamPtr.get() << tab_3 << "exit(255);" << endl_tab_2 << "}" << endl;
+    *streamPtr.get() << tab_2 << my << "($ft, $warnings, $lineCount, $warningTags, $kernels, $tags) = @{Storable::retrieve(\"$dir/$i.stats\")};" << endl;
+    *streamPtr.get() << tab_2 << "addStats(\\%tt, $ft);" << endl;
+    *streamPtr.get() << tab_2 << "$Twarnings += $warnings;" << endl;
+    *streamPtr.get() << tab_2 << "$TlineCount += $lineCount;" << endl;
+    *streamPtr.get() << tab_2 << "addStats(\\%TwarningTags, $warningTags);" << endl;
+    *streamPtr.get() << tab_2 << "addStats(\\%Tkernels, $kernels);" << endl;
+    *streamPtr.get() << tab_2 << "addStats(\\%convertedTags, $tags);" << endl_tab << "}" << endl;
+    *streamPtr.get() << tab << "File::Path::rmtree($dir);" << endl << "}" << endl;
   }
 
   bool generate(bool Generate) {
@@ -442,6 +609,7 @@ namespace perl {
     generateKernelLaunch(streamPtr);
     generateCubNamespace(streamPtr);
     generateHostFunctions(streamPtr);
+    generateFunctionsLookup(streamPtr);
     generateDeviceFunctions(streamPtr);
     generateDeprecatedAndUnsupportedFunctions(streamPtr);
     *streamPtr.get() << endl << "# Count of transforms in all files" << endl;
@@ -451,8 +619,9 @@ namespace perl {
     *streamPtr.get() << "$TlineCount = 0;" << endl;
     *streamPtr.get() << my << "%TwarningTags;" << endl;
     *streamPtr.get() << my << "$fileCount = @ARGV;" << endl_2;
-    *streamPtr.get() << while_ << "(@ARGV) {" << endl;
-    *streamPtr.get() << tab << "$fileName=shift (@ARGV);" << endl;
+    *streamPtr.get() << "# Hipify a file, adding its statistics to the totals for all files" << endl;
+    *streamPtr.get() << sub << "hipifyFile" << " {" << endl;
+    *streamPtr.get() << tab << "$fileName = shift();" << endl;
     *streamPtr.get() << tab << "my $direxclude = 0;" << endl;
     *streamPtr.get() << tab << "$fileDir=dirname($fileName);" << endl;
     *streamPtr.get() << tab <<  while_ << "(($direxclude == 0) and ($fileDir ne \".\" and $fileDir ne \"/\"))  { " << endl;
@@ -511,8 +680,7 @@ namespace perl {
     *streamPtr.get() << tab_5 << foreach << "(@lines) {" << endl;
     *streamPtr.get() << tab_6 << "$line_num++;" << endl;
     *streamPtr.get() << tab_6 << "# Remove any whitelisted words" << endl;
-    *streamPtr.get() << tab_6 << foreach << "$w (@whitelist) {" << endl;
-    *streamPtr.get() << tab_7 << "redo if s/\\b$w\\b/ZAP/" << endl_tab_6 << "}" << endl;
+    *streamPtr.get() << tab_6 << "s/$whitelistRegex/ZAP/g;" << endl;
     *streamPtr.get() << tab_6 << my << "$tag;" << endl;
     *streamPtr.get() << tab_6 << "if ((/(\\bcuda[A-Z]\\w+)/) or (/<<<.*>>>/)) {" << endl;
     *streamPtr.get() << tab_7 << "# Flag any remaining code that look like cuda API calls: may want to add these to hipify" << endl;
@@ -554,6 +722,12 @@ namespace perl {
     *streamPtr.get() << tab_3 << "$TwarningTags{$key} += $warningTags{$key};" << endl_tab_2 << "}";
     *streamPtr.get() << endl_tab << "}   # Unless filtered direcotry or file " << endl;
     *streamPtr.get() << "}" << endl;
+    generateParallel(streamPtr);
+    *streamPtr.get() << endl << "if ($jobs > 1 and $fileCount > 1) {" << endl;
+    *streamPtr.get() << tab << "hipifyFilesInParallel();" << endl;
+    *streamPtr.get() << "} else {" << endl;
+    *streamPtr.get() << tab << while_ << "(@ARGV) {" << endl;
+    *streamPtr.get() << tab_2 << "hipifyFile(shift(@ARGV));" << endl_tab << "}" << endl << "}" << endl;
     *streamPtr.get() << "# Print total stats for all files processed:" << endl;
     *streamPtr.get() << "if ($print_stats and ($fileCount > 1)) {" << endl;
     *streamPtr.get() << tab << print << "\"\\n\";" << endl;
@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 
 #include <sstream>
+#include <vector>
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Path.h"
@@ -30,6 +31,7 @@ THE SOFTWARE.
 #include "StringUtils.h"
 #include "LLVMCompat.h"
 #include "Statistics.h"
+#include "MappingsTable.h"
 
 using namespace llvm;
 
@@ -56,37 +58,62 @@ namespace python {
       return false;
     }
     std::unique_ptr<std::ostream> pythonStreamPtr = std::unique_ptr<std::ostream>(new std::ofstream(tmpFile.c_str(), std::ios_base::trunc));
-    *pythonStreamPtr.get() << "import collections\n\n";
-    *pythonStreamPtr.get() << "from pyHIPIFY.constants import *\n\n";
-    *pythonStreamPtr.get() << "CUDA_RENAMES_MAP = collections.OrderedDict([\n";
-    const std::string sHIP_UNS = ", HIP_UNSUPPORTED";
+    // The entries are grouped in runs of the same conversion type, API type and support: the CUDA and HIP names of
+    // a run make a tuple of string literals, which Python folds into a single constant, so that importing the
+    // compiled map is mostly unmarshalling the strings, rather than evaluating a tuple expression per entry.
+    struct PythonRename {
+      std::string cudaName;
+      std::string hipName;
+      int convType;
+      int apiType;
+      bool unsupported;
+    };
+    std::vector<PythonRename> renames;
     for (int i = 0; i < NUM_CONV_TYPES; ++i) {
       if (i == CONV_INCLUDE_CUDA_MAIN_H || i == CONV_INCLUDE) {
         for (auto &ma : CUDA_INCLUDE_MAP) {
           if (i == ma.second.type) {
-            std::string sUnsupported;
-            if (Statistics::isUnsupported(ma.second)) {
-              sUnsupported = sHIP_UNS;
-            }
             StringRef repName = Statistics::isToRoc(ma.second) ? ma.second.rocName : ma.second.hipName;
-            *pythonStreamPtr.get() << "    (\"" << ma.first.str() << "\", (\"" << repName.str() << "\", " << counterTypes[i] << ", " << apiTypes[ma.second.apiType] << sUnsupported << ")),\n";
+            renames.push_back({ma.first.str(), repName.str(), i, ma.second.apiType, Statistics::isUnsupported(ma.second)});
           }
         }
       }
       else {
-        for (auto &ma : CUDA_RENAMES_MAP()) {
-          if (i == ma.second.type) {
-            std::string sUnsupported;
-            if (Statistics::isUnsupported(ma.second)) {
-              sUnsupported = sHIP_UNS;
-            }
-            StringRef repName = Statistics::isToRoc(ma.second) ? ma.second.rocName : ma.second.hipName;
-            *pythonStreamPtr.get() << "    (\"" << ma.first.str() << "\", (\"" << repName.str() << "\", " << counterTypes[i] << ", " << apiTypes[ma.second.apiType] << sUnsupported << ")),\n";
-          }
+        const MappingsTable &table = MappingsTable::get();
+        for (auto id : table.getRenames(ConvTypes(i))) {
+          const hipCounter &counter = table.getCounter(id);
+          StringRef repName = Statistics::isToRoc(counter) ? counter.rocName : counter.hipName;
+          renames.push_back({table.getCudaName(id).str(), repName.str(), i, counter.apiType, Statistics::isUnsupported(counter)});
         }
       }
     }
-    *pythonStreamPtr.get() << "])\n\n";
+    *pythonStreamPtr.get() << "from pyHIPIFY.constants import *\n\n";
+    *pythonStreamPtr.get() << "# (conversion type, API type, unsupported, (CUDA name, HIP name, ...))\n";
+    *pythonStreamPtr.get() << "_CUDA_RENAMES = (\n";
+    for (size_t i = 0; i < renames.size(); ++i) {
+      const PythonRename &r = renames[i];
+      const bool runStart = i == 0 || r.convType != renames[i - 1].convType || r.apiType != renames[i - 1].apiType ||
+                            r.unsupported != renames[i - 1].unsupported;
+      if (runStart) {
+        if (i > 0) {
+          *pythonStreamPtr.get() << "    )),\n";
+        }
+        *pythonStreamPtr.get() << "    (" << counterTypes[r.convType] << ", " << apiTypes[r.apiType] << ", " << (r.unsupported ? "True" : "False") << ", (\n";
+      }
+      *pythonStreamPtr.get() << "        \"" << r.cudaName << "\", \"" << r.hipName << "\",\n";
+    }
+    if (!renames.empty()) {
+      *pythonStreamPtr.get() << "    )),\n";
+    }
+    *pythonStreamPtr.get() << ")\n\n\n";
+    *pythonStreamPtr.get() << "def _cuda_renames():\n";
+    *pythonStreamPtr.get() << "    for conv_type, api_type, unsupported, names in _CUDA_RENAMES:\n";
+    *pythonStreamPtr.get() << "        meta = (conv_type, api_type, HIP_UNSUPPORTED) if unsupported else (conv_type, api_type)\n";
+    *pythonStreamPtr.get() << "        for i in range(0, len(names), 2):\n";
+    *pythonStreamPtr.get() << "            yield names[i], (names[i + 1],) + meta\n\n\n";
+    *pythonStreamPtr.get() << "# Ordered as hipify-clang lists the mappings: dicts keep the insertion order.\n";
+    *pythonStreamPtr.get() << "CUDA_RENAMES_MAP = dict(_cuda_renames())\n";
+    *pythonStreamPtr.get() << "del _cuda_renames, _CUDA_RENAMES\n\n";
     *pythonStreamPtr.get() << "CUDA_TO_HIP_MAPPINGS = [CUDA_RENAMES_MAP, C10_MAPPINGS, PYTORCH_SPECIFIC_MAPPINGS]\n";
     pythonStreamPtr.get()->flush();
     bool ret = true;
@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_RAND_FUNCTION_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_RAND_FUNCTION_MAP {
   // RAND Host functions
   {"curandCreateGenerator",                         {"hiprandCreateGenerator",                         "", CONV_LIB_FUNC, API_RAND, 2}},
   {"curandCreateGeneratorHost",                     {"hiprandCreateGeneratorHost",                     "", CONV_LIB_FUNC, API_RAND, 2}},
@@ -85,14 +85,14 @@ const std::map<llvm::StringRef, hipCounter> CUDA_RAND_FUNCTION_MAP {
   // unchanged function names: skipahead, skipahead_sequence, skipahead_subsequence
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_RAND_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_RAND_FUNCTION_VER_MAP {
   {"curandGetProperty",                             {CUDA_80,  CUDA_0, CUDA_0}},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_RAND_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_RAND_FUNCTION_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_RAND_API_SECTION_MAP {
+const SortedMap<unsigned int, llvm::StringRef> CUDA_RAND_API_SECTION_MAP {
   {1, "CURAND Data types"},
   {2, "Host API Functions"},
   {3, "Device API Functions"},
@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Map of all functions
-const std::map<llvm::StringRef, hipCounter> CUDA_RAND_TYPE_NAME_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_RAND_TYPE_NAME_MAP {
   // RAND defines
   {"CURAND_VER_MAJOR",              {"HIPRAND_VER_MAJOR",              "", CONV_DEFINE, API_RAND, 1, HIP_UNSUPPORTED}},
   {"CURAND_VER_MINOR",              {"HIPRAND_VER_MINOR",              "", CONV_DEFINE, API_RAND, 1, HIP_UNSUPPORTED}},
@@ -140,7 +140,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_RAND_TYPE_NAME_MAP {
   {"CURAND_POISSON",                                {"HIPRAND_POISSON",                                "", CONV_NUMERIC_LITERAL, API_RAND, 1, HIP_UNSUPPORTED}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_RAND_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_RAND_TYPE_NAME_VER_MAP {
   {"CURAND_VER_MAJOR",                              {CUDA_102, CUDA_0, CUDA_0}},
   {"CURAND_VER_MINOR",                              {CUDA_102, CUDA_0, CUDA_0}},
   {"CURAND_VER_PATCH",                              {CUDA_102, CUDA_0, CUDA_0}},
@@ -149,5 +149,5 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_RAND_TYPE_NAME_VER_MAP {
   {"CURAND_ORDERING_PSEUDO_LEGACY",                 {CUDA_110, CUDA_0, CUDA_0}},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_RAND_TYPE_NAME_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_RAND_TYPE_NAME_VER_MAP {
 };
@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "CUDA2HIP.h"
 
 // Maps the names of CUDA SPARSE API functions to the corresponding HIP functions
-const std::map<llvm::StringRef, hipCounter> CUDA_SPARSE_FUNCTION_MAP {
+const SortedMap<llvm::StringRef, hipCounter> CUDA_SPARSE_FUNCTION_MAP {
   // 5. cuSPARSE Management Function Reference
   {"cusparseCreate",                                    {"hipsparseCreate",                                    "", CONV_LIB_FUNC, API_SPARSE, 5}},
   {"cusparseDestroy",                                   {"hipsparseDestroy",                                   "", CONV_LIB_FUNC, API_SPARSE, 5}},
@@ -384,7 +384,6 @@ const std::map<llvm::StringRef, hipCounter> CUDA_SPARSE_FUNCTION_MAP {
   {"cusparseDcsrilu02",                                 {"hipsparseDcsrilu02",                                 "", CONV_LIB_FUNC, API_SPARSE, 11}},
   {"cusparseCcsrilu02",                                 {"hipsparseCcsrilu02",                                 "", CONV_LIB_FUNC, API_SPARSE, 11}},
   {"cusparseZcsrilu02",                                 {"hipsparseZcsrilu02",                                 "", CONV_LIB_FUNC, API_SPARSE, 11}},
-  {"cusparseXbsric02_zeroPivot",                        {"hipsparseXcsrilu02_zeroPivot",                       "", CONV_LIB_FUNC, API_SPARSE, 11}},
 
   {"cusparseSbsrilu02_numericBoost",                    {"hipsparseSbsrilu02_numericBoost",                    "", CONV_LIB_FUNC, API_SPARSE, 11}},
   {"cusparseDbsrilu02_numericBoost",                    {"hipsparseDbsrilu02_numericBoost",                    "", CONV_LIB_FUNC, API_SPARSE, 11}},
@@ -781,7 +780,7 @@ const std::map<llvm::StringRef, hipCounter> CUDA_SPARSE_FUNCTION_MAP {
   {"cusparseDenseToSparse_convert",                     {"hipsparseDenseToSparse_convert",                     "", CONV_LIB_FUNC, API_SPARSE, 14, HIP_UNSUPPORTED}},
 };
 
-const std::map<llvm::StringRef, cudaAPIversions> CUDA_SPARSE_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, cudaAPIversions> CUDA_SPARSE_FUNCTION_VER_MAP {
   {"cusparseCreateCsrgemm2Info",                        {CUDA_0,   CUDA_110, CUDA_0  }},
   {"cusparseCreateCsrsm2Info",                          {CUDA_100, CUDA_0,   CUDA_0  }},
   {"cusparseCreateHybMat",                              {CUDA_0,   CUDA_102, CUDA_110}},
@@ -1134,10 +1133,10 @@ const std::map<llvm::StringRef, cudaAPIversions> CUDA_SPARSE_FUNCTION_VER_MAP {
   {"cusparseDenseToSparse_convert",                     {CUDA_111, CUDA_0,   CUDA_0  }},
 };
 
-const std::map<llvm::StringRef, hipAPIversions> HIP_SPARSE_FUNCTION_VER_MAP {
+const SortedMap<llvm::StringRef, hipAPIversions> HIP_SPARSE_FUNCTION_VER_MAP {
 };
 
-const std::map<unsigned int, llvm::StringRef> CUDA_SPARSE_API_SECTION_MAP {
+const SortedMap<unsigned int, llvm::StringRef> CUDA_SPARSE_API_SECTION_MAP {
   {4, "CUSPARSE Types References"},
   {5, "CUSPARSE Management Function Reference"},
   {6, "CUSPARSE Helper Function Reference"},
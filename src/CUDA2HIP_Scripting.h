@@ -40,6 +40,11 @@ namespace python {
   bool generate(bool Generate = true);
 }
 
+namespace mappingsdb {
+
+  bool generate(bool Generate = true);
+}
+
 namespace doc {
 
   bool generate(bool GenerateMD = true, bool GenerateCSV = true);
@@ -28,6 +28,9 @@ THE SOFTWARE.
 #include "clang/ASTMatchers/ASTMatchFinder.h"
 #include "clang/ASTMatchers/ASTMatchers.h"
 #include "clang/Lex/HeaderSearch.h"
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/RecursiveASTVisitor.h"
 #include "LLVMCompat.h"
 #include "CUDA2HIP.h"
 #include "StringUtils.h"
@@ -91,21 +94,18 @@ std::set<std::string> ReinterpretFunctions1{
 };
 
 void HipifyAction::RewriteString(StringRef s, clang::SourceLocation start) {
-  auto &SM = getCompilerInstance().getSourceManager();
   size_t begin = 0;
   while ((begin = s.find("cu", begin)) != StringRef::npos) {
     const size_t end = s.find_first_of(" ", begin + 4);
     StringRef name = s.slice(begin, end);
     const auto found = CUDA_RENAMES_MAP().find(name);
     if (found != CUDA_RENAMES_MAP().end()) {
-      StringRef repName = Statistics::isToRoc(found->second) ? found->second.rocName : found->second.hipName;
-      hipCounter counter = {s_string_literal, "", ConvTypes::CONV_LITERAL, ApiTypes::API_RUNTIME, found->second.supportDegree};
-      Statistics::current().incrementCounter(counter, name.str());
+      StringRef repName = Statistics::isToRoc(*found->second) ? found->second->rocName : found->second->hipName;
+      hipCounter counter = {s_string_literal, "", ConvTypes::CONV_LITERAL, ApiTypes::API_RUNTIME, found->second->supportDegree};
+      clang::SourceLocation sl = start.getLocWithOffset(begin + 1);
+      countReference(counter, name, sl);
       if (!Statistics::isUnsupported(counter)) {
-        clang::SourceLocation sl = start.getLocWithOffset(begin + 1);
-        ct::Replacement Rep(SM, sl, name.size(), repName.str());
-        clang::FullSourceLoc fullSL(sl, SM);
-        insertReplacement(Rep, fullSL);
+        insertReplacement(sl, name.size(), repName);
       }
     }
     if (end == StringRef::npos) break;
@@ -150,23 +150,45 @@ void HipifyAction::RewriteToken(const clang::Token &t) {
 
 void HipifyAction::FindAndReplace(StringRef name,
                                   clang::SourceLocation sl,
-                                  const std::map<StringRef, hipCounter> &repMap,
+                                  const SortedMap<StringRef, hipCounter> &repMap,
                                   bool bReplace) {
   const auto found = repMap.find(name);
   if (found == repMap.end()) {
     // So it's an identifier, but not CUDA? Boring.
     return;
   }
-  Statistics::current().incrementCounter(found->second, name.str());
+  ReplaceIdentifier(name, sl, found->second, bReplace);
+}
+
+void HipifyAction::FindAndReplace(StringRef name,
+                                  clang::SourceLocation sl,
+                                  const SortedMap<StringRef, const hipCounter*> &repMap,
+                                  bool bReplace) {
+  const auto found = repMap.find(name);
+  if (found == repMap.end()) {
+    return;
+  }
+  ReplaceIdentifier(name, sl, *found->second, bReplace);
+}
+
+void HipifyAction::ReplaceIdentifier(StringRef name,
+                                     clang::SourceLocation sl,
+                                     const hipCounter &counter,
+                                     bool bReplace) {
+  countReference(counter, name, sl);
   clang::DiagnosticsEngine &DE = getCompilerInstance().getDiagnostics();
   // Warn the user about deprecated idenrifier.
-  if (Statistics::isDeprecated(found->second)) {
+  if (Statistics::isDeprecated(counter)) {
     DE.Report(sl, DE.getCustomDiagID(clang::DiagnosticsEngine::Warning, "CUDA identifier is deprecated."));
   }
+  // Warn the user about removed identifier.
+  if (Statistics::isRemoved(counter)) {
+    DE.Report(sl, DE.getCustomDiagID(clang::DiagnosticsEngine::Warning, "CUDA identifier is removed."));
+  }
   // Warn the user about unsupported identifier.
-  if (Statistics::isUnsupported(found->second)) {
+  if (Statistics::isUnsupported(counter)) {
     std::string sWarn;
-    Statistics::isToRoc(found->second) ? sWarn = sROC : sWarn = sHIP;
+    Statistics::isToRoc(counter) ? sWarn = sROC : sWarn = sHIP;
     sWarn = "" + sWarn;
     const auto ID = DE.getCustomDiagID(clang::DiagnosticsEngine::Warning, "CUDA identifier is unsupported in %0.");
     DE.Report(sl, ID) << sWarn;
@@ -175,11 +197,8 @@ void HipifyAction::FindAndReplace(StringRef name,
   if (!bReplace) {
     return;
   }
-  StringRef repName = Statistics::isToRoc(found->second) ? found->second.rocName : found->second.hipName;
-  auto &SM = getCompilerInstance().getSourceManager();
-  ct::Replacement Rep(SM, sl, name.size(), repName.str());
-  clang::FullSourceLoc fullSL(sl, SM);
-  insertReplacement(Rep, fullSL);
+  StringRef repName = Statistics::isToRoc(counter) ? counter.rocName : counter.hipName;
+  insertReplacement(sl, name.size(), repName);
 }
 
 namespace {
@@ -297,8 +316,8 @@ void HipifyAction::InclusionDirective(clang::SourceLocation hash_loc,
   const auto found = CUDA_INCLUDE_MAP.find(file_name);
   if (found == CUDA_INCLUDE_MAP.end()) return;
   bool exclude = Exclude(found->second);
-  Statistics::current().incrementCounter(found->second, file_name.str());
   clang::SourceLocation sl = filename_range.getBegin();
+  countReference(found->second, file_name, sl);
   if (Statistics::isUnsupported(found->second)) {
     clang::DiagnosticsEngine &DE = getCompilerInstance().getDiagnostics();
     DE.Report(sl, DE.getCustomDiagID(clang::DiagnosticsEngine::Warning, "Unsupported CUDA header."));
@@ -317,8 +336,7 @@ void HipifyAction::InclusionDirective(clang::SourceLocation hash_loc,
   }
   const char *B = SM.getCharacterData(sl);
   const char *E = SM.getCharacterData(filename_range.getEnd());
-  ct::Replacement Rep(SM, sl, E - B, newInclude.str());
-  insertReplacement(Rep, clang::FullSourceLoc{sl, SM});
+  insertReplacement(sl, E - B, newInclude);
 }
 
 void HipifyAction::PragmaDirective(clang::SourceLocation Loc, clang::PragmaIntroducerKind Introducer) {
@@ -335,8 +353,7 @@ void HipifyAction::PragmaDirective(clang::SourceLocation Loc, clang::PragmaIntro
   }
 }
 
-bool HipifyAction::cudaLaunchKernel(const mat::MatchFinder::MatchResult &Result) {
-  auto *launchKernel = Result.Nodes.getNodeAs<clang::CUDAKernelCallExpr>(sCudaLaunchKernel);
+bool HipifyAction::cudaLaunchKernel(const clang::CUDAKernelCallExpr *launchKernel) {
   if (!launchKernel) return false;
   auto *calleeExpr = launchKernel->getCallee();
   if (!calleeExpr) return false;
@@ -347,7 +364,7 @@ bool HipifyAction::cudaLaunchKernel(const mat::MatchFinder::MatchResult &Result)
   clang::SmallString<40> XStr;
   llvm::raw_svector_ostream OS(XStr);
   clang::LangOptions DefaultLangOptions;
-  auto *SM = Result.SourceManager;
+  auto *SM = &getCompilerInstance().getSourceManager();
   clang::SourceRange sr = calleeExpr->getSourceRange();
   std::string kern = readSourceText(*SM, sr).str();
   OS << sHipLaunchKernelGGL << "(";
@@ -401,18 +418,15 @@ bool HipifyAction::cudaLaunchKernel(const mat::MatchFinder::MatchResult &Result)
   clang::SourceLocation launchEnd = replacementRange.getEnd();
   if (isBefore(launchBeg, launchEnd)) {
     size_t length = SM->getCharacterData(clang::Lexer::getLocForEndOfToken(launchEnd, 0, *SM, DefaultLangOptions)) - SM->getCharacterData(launchBeg);
-    ct::Replacement Rep(*SM, launchBeg, length, OS.str());
-    clang::FullSourceLoc fullSL(launchBeg, *SM);
-    insertReplacement(Rep, fullSL);
+    insertReplacement(launchBeg, length, OS.str());
     hipCounter counter = {sHipLaunchKernelGGL, "", ConvTypes::CONV_KERNEL_LAUNCH, ApiTypes::API_RUNTIME};
-    Statistics::current().incrementCounter(counter, sCudaLaunchKernel.str());
+    countReference(counter, sCudaLaunchKernel, launchBeg);
     return true;
   }
   return false;
 }
 
-bool HipifyAction::cudaSharedIncompleteArrayVar(const mat::MatchFinder::MatchResult &Result) {
-  auto *sharedVar = Result.Nodes.getNodeAs<clang::VarDecl>(sCudaSharedIncompleteArrayVar);
+bool HipifyAction::cudaSharedIncompleteArrayVar(const clang::VarDecl *sharedVar) {
   if (!sharedVar) return false;
   // Example: extern __shared__ uint sRadix1[];
   if (!sharedVar->hasExternalFormalLinkage()) return false;
@@ -437,22 +451,20 @@ bool HipifyAction::cudaSharedIncompleteArrayVar(const mat::MatchFinder::MatchRes
   if (!typeName.empty()) {
     clang::SourceLocation slStart = sharedVar->getOuterLocStart();
     clang::SourceLocation slEnd = llcompat::getEndLoc(sharedVar->getTypeSourceInfo()->getTypeLoc());
-    auto *SM = Result.SourceManager;
+    auto *SM = &getCompilerInstance().getSourceManager();
     size_t repLength = SM->getCharacterData(slEnd) - SM->getCharacterData(slStart) + 1;
     std::string varName = sharedVar->getNameAsString();
     std::string repName = sHIP_DYNAMIC_SHARED + "(" + typeName + ", " + varName + ")";
-    ct::Replacement Rep(*SM, slStart, repLength, repName);
-    clang::FullSourceLoc fullSL(slStart, *SM);
-    insertReplacement(Rep, fullSL);
+    insertReplacement(slStart, repLength, repName);
     hipCounter counter = {sHIP_DYNAMIC_SHARED, "", ConvTypes::CONV_EXTERN_SHARED, ApiTypes::API_RUNTIME};
-    Statistics::current().incrementCounter(counter, sCudaSharedIncompleteArrayVar.str());
+    countReference(counter, sCudaSharedIncompleteArrayVar, slStart);
     return true;
   }
   return false;
 }
 
-bool HipifyAction::cudaDeviceFuncCall(const mat::MatchFinder::MatchResult &Result) {
-  if (const clang::CallExpr *call = Result.Nodes.getNodeAs<clang::CallExpr>(sCudaDeviceFuncCall)) {
+bool HipifyAction::cudaDeviceFuncCall(const clang::CallExpr *call) {
+  if (call) {
     auto *funcDcl = call->getDirectCallee();
     if (!funcDcl) return false;
     FindAndReplace(funcDcl->getDeclName().getAsString(), llcompat::getBeginLoc(call), CUDA_DEVICE_FUNC_MAP, false);
@@ -461,8 +473,8 @@ bool HipifyAction::cudaDeviceFuncCall(const mat::MatchFinder::MatchResult &Resul
   return false;
 }
 
-bool HipifyAction::cubNamespacePrefix(const mat::MatchFinder::MatchResult &Result) {
-  if (auto *decl = Result.Nodes.getNodeAs<clang::TypedefNameDecl>(sCubNamespacePrefix)) {
+bool HipifyAction::cubNamespacePrefix(const clang::TypedefNameDecl *decl) {
+  if (decl) {
     clang::QualType QT = decl->getUnderlyingType();
     auto *t = QT.getTypePtr();
     if (!t) return false;
@@ -482,8 +494,8 @@ bool HipifyAction::cubNamespacePrefix(const mat::MatchFinder::MatchResult &Resul
   return false;
 }
 
-bool HipifyAction::cubUsingNamespaceDecl(const mat::MatchFinder::MatchResult &Result) {
-  if (auto *decl = Result.Nodes.getNodeAs<clang::UsingDirectiveDecl>(sCubUsingNamespaceDecl)) {
+bool HipifyAction::cubUsingNamespaceDecl(const clang::UsingDirectiveDecl *decl) {
+  if (decl) {
     if (auto nsd = decl->getNominatedNamespace()) {
       FindAndReplace(nsd->getDeclName().getAsString(), decl->getIdentLocation(), CUDA_CUB_TYPE_NAME_MAP);
       return true;
@@ -492,8 +504,8 @@ bool HipifyAction::cubUsingNamespaceDecl(const mat::MatchFinder::MatchResult &Re
   return false;
 }
 
-bool HipifyAction::cubFunctionTemplateDecl(const mat::MatchFinder::MatchResult &Result) {
-  if (auto *decl = Result.Nodes.getNodeAs<clang::FunctionTemplateDecl>(sCubFunctionTemplateDecl)) {
+bool HipifyAction::cubFunctionTemplateDecl(const clang::FunctionTemplateDecl *decl) {
+  if (decl) {
     auto *Tparams = decl->getTemplateParameters();
     bool ret = false;
     for (size_t I = 0; I < Tparams->size(); ++I) {
@@ -518,8 +530,8 @@ bool HipifyAction::cubFunctionTemplateDecl(const mat::MatchFinder::MatchResult &
   return false;
 }
 
-bool HipifyAction::cudaHostFuncCall(const mat::MatchFinder::MatchResult &Result) {
-  if (auto *call = Result.Nodes.getNodeAs<clang::CallExpr>(sCudaHostFuncCall)) {
+bool HipifyAction::cudaHostFuncCall(const clang::CallExpr *call) {
+  if (call) {
     if (!call->getNumArgs()) return false;
     auto *funcDcl = call->getDirectCallee();
     if (!funcDcl) return false;
@@ -536,34 +548,326 @@ bool HipifyAction::cudaHostFuncCall(const mat::MatchFinder::MatchResult &Result)
     clang::SmallString<40> XStr;
     llvm::raw_svector_ostream OS(XStr);
     clang::SourceRange sr = call->getArg(argNum)->getSourceRange();
-    auto *SM = Result.SourceManager;
+    auto *SM = &getCompilerInstance().getSourceManager();
     OS << (b_reinterpret ? s_reinterpret_cast : sHIP_SYMBOL) << "(" << readSourceText(*SM, sr) << ")";
     clang::SourceRange replacementRange = getWriteRange(*SM, { sr.getBegin(), sr.getEnd() });
     clang::SourceLocation s = replacementRange.getBegin();
     clang::SourceLocation e = replacementRange.getEnd();
     clang::LangOptions DefaultLangOptions;
     size_t length = SM->getCharacterData(clang::Lexer::getLocForEndOfToken(e, 0, *SM, DefaultLangOptions)) - SM->getCharacterData(s);
-    ct::Replacement Rep(*SM, s, length, OS.str());
-    clang::FullSourceLoc fullSL(s, *SM);
-    insertReplacement(Rep, fullSL);
+    insertReplacement(s, length, OS.str());
     return true;
   }
   return false;
 }
 
-void HipifyAction::insertReplacement(const ct::Replacement &rep, const clang::FullSourceLoc &fullSL) {
-  llcompat::insertReplacement(*replacements, rep);
+void HipifyAction::countReference(const hipCounter &counter, StringRef name, clang::SourceLocation sl) {
+  Statistics &stat = Statistics::current();
+  stat.incrementCounter(counter, name.str());
+  if (Statistics::isUsageIndexed()) {
+    clang::FullSourceLoc fullLoc(sl, getCompilerInstance().getSourceManager());
+    stat.recordUsage(counter, name.str(), fullLoc.getExpansionLineNumber(), fullLoc.getExpansionColumnNumber());
+  }
+}
+
+void HipifyAction::insertReplacement(clang::SourceLocation sl, unsigned length, StringRef text) {
+  auto &SM = getCompilerInstance().getSourceManager();
+  // The same decomposition as ct::Replacement does, but the file path is computed once per file.
+  std::pair<clang::FileID, unsigned> decomposedLoc = SM.getDecomposedLoc(sl);
+  auto file = replacementFiles.insert(std::make_pair(decomposedLoc.first, unsigned(replacementFileLocs.size())));
+  if (file.second) {
+    replacementFileLocs.push_back(sl);
+  }
+  unsigned order = unsigned(pendingReplacements.size());
+  pendingReplacements.push_back({file.first->second, decomposedLoc.second, length, order, StringRef(replacementTextSaver.save(text))});
   if (PrintStats) {
-    rep.getLength();
-    Statistics::current().lineTouched(fullSL.getExpansionLineNumber());
-    Statistics::current().bytesChanged(rep.getLength());
+    Statistics::current().lineTouched(clang::FullSourceLoc(sl, SM).getExpansionLineNumber());
+    Statistics::current().bytesChanged(length);
+  }
+}
+
+void HipifyAction::applyReplacements() {
+  auto &SM = getCompilerInstance().getSourceManager();
+  auto overlap = [](const PendingReplacement &r1, const PendingReplacement &r2) {
+    return r1.offset + r1.length > r2.offset && r2.offset + r2.length > r1.offset;
+  };
+  std::stable_sort(pendingReplacements.begin(), pendingReplacements.end(),
+    [](const PendingReplacement &r1, const PendingReplacement &r2) {
+      return r1.fileIndex != r2.fileIndex ? r1.fileIndex < r2.fileIndex : r1.offset < r2.offset;
+    }
+  );
+  // Resolve conflicts the same way ct::Replacements::add() does when replacements are inserted one by one:
+  // a replacement overlapping an earlier inserted one is dropped, insertions at the same offset are merged
+  // if their order doesn't matter. Conflicts are only possible within a cluster of consecutive replacements
+  // of the same file, which might overlap; as a rule, such a cluster consists of a single replacement.
+  std::vector<PendingReplacement> resolved, cluster;
+  resolved.reserve(pendingReplacements.size());
+  for (auto it = pendingReplacements.begin(); it != pendingReplacements.end();) {
+    unsigned clusterEnd = it->offset + it->length;
+    auto next = std::next(it);
+    while (next != pendingReplacements.end() && next->fileIndex == it->fileIndex &&
+           (next->offset < clusterEnd || next->offset == std::prev(next)->offset)) {
+      clusterEnd = std::max(clusterEnd, next->offset + next->length);
+      ++next;
+    }
+    if (std::next(it) == next) {
+      resolved.push_back(*it);
+      it = next;
+      continue;
+    }
+    cluster.assign(it, next);
+    std::sort(cluster.begin(), cluster.end(),
+      [](const PendingReplacement &r1, const PendingReplacement &r2) { return r1.order < r2.order; });
+    size_t accepted = resolved.size();
+    for (const auto &r : cluster) {
+      bool bAccept = true;
+      for (size_t i = accepted; i < resolved.size() && bAccept; ++i) {
+        PendingReplacement &a = resolved[i];
+        if (0 == r.length && 0 == a.length && r.offset == a.offset) {
+          bAccept = false;
+          std::string merged = (r.text + a.text).str();
+          if (merged == (a.text + r.text).str()) {
+            a.text = StringRef(replacementTextSaver.save(merged));
+          }
+        } else if (overlap(r, a)) {
+          bAccept = false;
+        }
+      }
+      if (bAccept) {
+        resolved.push_back(r);
+      }
+    }
+    it = next;
+  }
+  std::vector<std::string> filePaths;
+  for (const auto &sl : replacementFileLocs) {
+    filePaths.push_back(ct::Replacement(SM, sl, 0, "").getFilePath().str());
+  }
+  for (const auto &r : resolved) {
+    llcompat::insertReplacement(*replacements, ct::Replacement(filePaths[r.fileIndex], r.offset, r.length, r.text));
   }
+  pendingReplacements.clear();
+}
+
+namespace {
+
+/**
+  * An ASTConsumer, which restricts the AST traversal of the wrapped consumer to the main file.
+  *
+  * All the matchers are bound to the main file, so there is no need to walk through declarations
+  * coming from CUDA or any other included headers. Top-level declarations, expanded in the main file,
+  * are collected while parsing and then set as the traversal scope right before the wrapped consumer
+  * handles the translation unit.
+  *
+  * With -skip-function-bodies-outside-main-file, the same main file filter is applied to function bodies:
+  * the parser skips the bodies of all the functions, which are not declared in the main file.
+  */
+class MainFileASTConsumer : public clang::ASTConsumer {
+  std::unique_ptr<clang::ASTConsumer> Consumer;
+  const clang::SourceManager &SM;
+  std::vector<clang::Decl*> MainFileDecls;
+
+public:
+  MainFileASTConsumer(std::unique_ptr<clang::ASTConsumer> consumer, const clang::SourceManager &sm):
+    Consumer(std::move(consumer)), SM(sm) {}
+
+  void Initialize(clang::ASTContext &Context) override {
+    Consumer->Initialize(Context);
+  }
+
+  bool HandleTopLevelDecl(clang::DeclGroupRef DG) override {
+    for (clang::Decl *D : DG) {
+      if (SM.isInMainFile(SM.getExpansionLoc(D->getLocation()))) {
+        MainFileDecls.push_back(D);
+      }
+    }
+    return Consumer->HandleTopLevelDecl(DG);
+  }
+
+#if !((LLVM_VERSION_MAJOR == 3) && (LLVM_VERSION_MINOR == 8))
+  bool shouldSkipFunctionBody(clang::Decl *D) override {
+    return !SM.isInMainFile(SM.getExpansionLoc(D->getLocation()));
+  }
+#endif
+
+  void HandleTranslationUnit(clang::ASTContext &Context) override {
+    llcompat::setTraversalScope(Context, MainFileDecls);
+    Consumer->HandleTranslationUnit(Context);
+  }
+};
+
+/**
+  * A MatchCallback, which counts matches of a single matcher and forwards them to HipifyAction.
+  *
+  * MatchFinder's profiling accumulates time per MatchCallback ID, so each matcher needs its own callback.
+  */
+class ProfilingMatchCallback : public mat::MatchFinder::MatchCallback {
+  mat::MatchFinder::MatchCallback &hipifyAction;
+  std::string matcherName;
+
+public:
+  ProfilingMatchCallback(mat::MatchFinder::MatchCallback &action, StringRef name): hipifyAction(action), matcherName(name.str()) {}
+
+  void run(const mat::MatchFinder::MatchResult &Result) override {
+    Statistics::current().matcherMatched(matcherName);
+    hipifyAction.run(Result);
+  }
+
+  StringRef getID() const override {
+    return matcherName;
+  }
+};
+
+/**
+  * A single-pass alternative to the AST matchers, registered in HipifyAction::CreateASTConsumer.
+  *
+  * Dispatches directly on the node kinds the matchers are interested in, checking the same conditions,
+  * and calls the corresponding HipifyAction listeners.
+  */
+class HipifyASTVisitor : public clang::RecursiveASTVisitor<HipifyASTVisitor> {
+  HipifyAction &hipifyAction;
+  const clang::SourceManager &SM;
+
+  bool isExpansionInMainFile(clang::SourceLocation sl) const {
+    return SM.isInMainFile(SM.getExpansionLoc(sl));
+  }
+
+  static bool isCubNamespace(const clang::NamespaceDecl *nsd) {
+    return nsd && nsd->getDeclName().isIdentifier() && nsd->getName() == sCub;
+  }
+
+  // Example: cub::BlockReduce<int, 128>
+  static bool isCubQualified(clang::QualType QT) {
+    auto *t = QT.getTypePtrOrNull();
+    if (!t) return false;
+    const clang::ElaboratedType *et = t->getAs<clang::ElaboratedType>();
+    if (!et || !et->getQualifier()) return false;
+    return isCubNamespace(et->getQualifier()->getAsNamespace());
+  }
+
+  static bool isCudaHostFunction(const clang::FunctionDecl *funcDecl) {
+    const clang::IdentifierInfo *II = funcDecl->getIdentifier();
+    if (!II || !II->getName().startswith("cuda")) return false;
+    std::string sName = II->getName().str();
+    return DeviceSymbolFunctions0.count(sName) || DeviceSymbolFunctions1.count(sName) || ReinterpretFunctions.count(sName);
+  }
+
+  static bool isCudaDeviceFunction(const clang::FunctionDecl *funcDecl) {
+    return (funcDecl->hasAttr<clang::CUDADeviceAttr>() || funcDecl->hasAttr<clang::CUDAGlobalAttr>()) &&
+           !funcDecl->hasAttr<clang::CUDAHostAttr>();
+  }
+
+public:
+  HipifyASTVisitor(HipifyAction &action, const clang::SourceManager &sm): hipifyAction(action), SM(sm) {}
+
+  bool shouldVisitTemplateInstantiations() const { return true; }
+  bool shouldVisitImplicitCode() const { return true; }
+
+  void TraverseTranslationUnit(clang::ASTContext &Context) {
+#if LLVM_VERSION_MAJOR >= 8
+    // Respects the traversal scope, set by MainFileASTConsumer.
+    TraverseAST(Context);
+#else
+    TraverseDecl(Context.getTranslationUnitDecl());
+#endif
+  }
+
+  bool VisitCUDAKernelCallExpr(clang::CUDAKernelCallExpr *launchKernel) {
+    if (isExpansionInMainFile(llcompat::getBeginLoc(launchKernel))) {
+      hipifyAction.cudaLaunchKernel(launchKernel);
+    }
+    return true;
+  }
+
+  bool VisitVarDecl(clang::VarDecl *var) {
+    if (var->hasAttr<clang::CUDASharedAttr>() && clang::isa<clang::IncompleteArrayType>(var->getType().getTypePtr()) &&
+        isExpansionInMainFile(llcompat::getBeginLoc(var))) {
+      hipifyAction.cudaSharedIncompleteArrayVar(var);
+    }
+    return true;
+  }
+
+  // Both host and device function calls, including kernel launches, which are also CallExprs.
+  bool VisitCallExpr(clang::CallExpr *call) {
+    auto *funcDecl = clang::dyn_cast_or_null<clang::FunctionDecl>(call->getCalleeDecl());
+    if (!funcDecl) return true;
+    bool bHost = isCudaHostFunction(funcDecl);
+    bool bDevice = isCudaDeviceFunction(funcDecl);
+    if (!bHost && !bDevice) return true;
+    if (!isExpansionInMainFile(llcompat::getBeginLoc(call))) return true;
+    if (bHost) hipifyAction.cudaHostFuncCall(call);
+    if (bDevice) hipifyAction.cudaDeviceFuncCall(call);
+    return true;
+  }
+
+  bool VisitTypedefDecl(clang::TypedefDecl *decl) {
+    auto *et = clang::dyn_cast<clang::ElaboratedType>(decl->getUnderlyingType().getTypePtr());
+    if (!et || !et->getQualifier() || !isCubNamespace(et->getQualifier()->getAsNamespace())) return true;
+    if (isExpansionInMainFile(llcompat::getBeginLoc(decl))) {
+      hipifyAction.cubNamespacePrefix(decl);
+    }
+    return true;
+  }
+
+  bool VisitFunctionTemplateDecl(clang::FunctionTemplateDecl *decl) {
+    bool bCub = false;
+    for (const clang::NamedDecl *param : *decl->getTemplateParameters()) {
+      auto *valueDecl = clang::dyn_cast<clang::ValueDecl>(param);
+      if (valueDecl && isCubQualified(valueDecl->getType())) {
+        bCub = true;
+        break;
+      }
+    }
+    if (bCub && isExpansionInMainFile(llcompat::getBeginLoc(decl))) {
+      hipifyAction.cubFunctionTemplateDecl(decl);
+    }
+    return true;
+  }
+
+  bool VisitUsingDirectiveDecl(clang::UsingDirectiveDecl *decl) {
+    if (isCubNamespace(decl->getNominatedNamespace()) && isExpansionInMainFile(llcompat::getBeginLoc(decl))) {
+      hipifyAction.cubUsingNamespaceDecl(decl);
+    }
+    return true;
+  }
+};
+
+/**
+  * An ASTConsumer, which runs HipifyASTVisitor over the translation unit.
+  */
+class HipifyASTVisitorConsumer : public clang::ASTConsumer {
+  HipifyASTVisitor Visitor;
+
+public:
+  HipifyASTVisitorConsumer(HipifyAction &action, const clang::SourceManager &sm): Visitor(action, sm) {}
+
+  void HandleTranslationUnit(clang::ASTContext &Context) override {
+    Visitor.TraverseTranslationUnit(Context);
+  }
+};
+
+} // anonymous namespace
+
+mat::MatchFinder::MatchCallback *HipifyAction::getMatchCallback(StringRef matcherName) {
+  if (!PrintMatcherProfile) {
+    return this;
+  }
+  ProfilingCallbacks.emplace_back(new ProfilingMatchCallback(*this, matcherName));
+  return ProfilingCallbacks.back().get();
 }
 
 std::unique_ptr<clang::ASTConsumer> HipifyAction::CreateASTConsumer(clang::CompilerInstance &CI, StringRef) {
-  Finder.reset(new mat::MatchFinder);
+  if (UseASTVisitor) {
+    std::unique_ptr<clang::ASTConsumer> Consumer(new HipifyASTVisitorConsumer(*this, CI.getSourceManager()));
+    return std::unique_ptr<clang::ASTConsumer>(new MainFileASTConsumer(std::move(Consumer), CI.getSourceManager()));
+  }
+  mat::MatchFinder::MatchFinderOptions Options;
+  if (PrintMatcherProfile) {
+    Options.CheckProfiling.emplace(MatcherTimeRecords);
+  }
+  Finder.reset(new mat::MatchFinder(std::move(Options)));
   // Replace the <<<...>>> language extension with a hip kernel launch
-  Finder->addMatcher(mat::cudaKernelCallExpr(mat::isExpansionInMainFile()).bind(sCudaLaunchKernel), this);
+  Finder->addMatcher(mat::cudaKernelCallExpr(mat::isExpansionInMainFile()).bind(sCudaLaunchKernel), getMatchCallback(sCudaLaunchKernel));
   Finder->addMatcher(
     mat::varDecl(
       mat::isExpansionInMainFile(),
@@ -572,7 +876,7 @@ std::unique_ptr<clang::ASTConsumer> HipifyAction::CreateASTConsumer(clang::Compi
         mat::hasType(mat::incompleteArrayType())
       )
     ).bind(sCudaSharedIncompleteArrayVar),
-    this
+    getMatchCallback(sCudaSharedIncompleteArrayVar)
   );
   Finder->addMatcher(
     mat::callExpr(
@@ -592,7 +896,7 @@ std::unique_ptr<clang::ASTConsumer> HipifyAction::CreateASTConsumer(clang::Compi
         )
       )
     ).bind(sCudaHostFuncCall),
-    this
+    getMatchCallback(sCudaHostFuncCall)
   );
   Finder->addMatcher(
     mat::callExpr(
@@ -607,7 +911,7 @@ std::unique_ptr<clang::ASTConsumer> HipifyAction::CreateASTConsumer(clang::Compi
         )
       )
     ).bind(sCudaDeviceFuncCall),
-    this
+    getMatchCallback(sCudaDeviceFuncCall)
   );
   Finder->addMatcher(
     mat::typedefDecl(
@@ -622,24 +926,24 @@ std::unique_ptr<clang::ASTConsumer> HipifyAction::CreateASTConsumer(clang::Compi
         )
        )
     ).bind(sCubNamespacePrefix),
-    this
+    getMatchCallback(sCubNamespacePrefix)
   );
   // TODO: Maybe worth to make it more concrete based on final cubFunctionTemplateDecl
   Finder->addMatcher(
     mat::functionTemplateDecl(
       mat::isExpansionInMainFile()
     ).bind(sCubFunctionTemplateDecl),
-    this
+    getMatchCallback(sCubFunctionTemplateDecl)
   );
   // TODO: Maybe worth to make it more concrete
   Finder->addMatcher(
     mat::usingDirectiveDecl(
       mat::isExpansionInMainFile()
     ).bind(sCubUsingNamespaceDecl),
-    this
+    getMatchCallback(sCubUsingNamespaceDecl)
   );
   // Ownership is transferred to the caller.
-  return Finder->newASTConsumer();
+  return std::unique_ptr<clang::ASTConsumer>(new MainFileASTConsumer(Finder->newASTConsumer(), CI.getSourceManager()));
 }
 
 void HipifyAction::Ifndef(clang::SourceLocation Loc, const clang::Token &MacroNameTok, const clang::MacroDefinition &MD) {
@@ -650,6 +954,10 @@ void HipifyAction::Ifndef(clang::SourceLocation Loc, const clang::Token &MacroNa
 }
 
 void HipifyAction::EndSourceFileAction() {
+  // MatchFinder fills the time records in at the end of matching the translation unit.
+  for (const auto &record : MatcherTimeRecords) {
+    Statistics::current().matcherTimed(record.getKey().str(), record.getValue().getWallTime());
+  }
   // Insert the hip header, if we didn't already do it by accident during substitution.
   if (!insertedRuntimeHeader) {
     // It's not sufficient to just replace CUDA headers with hip ones, because numerous CUDA headers are
@@ -679,10 +987,9 @@ void HipifyAction::EndSourceFileAction() {
       if (firstHeader)               sl = firstHeaderLoc;
       else                           sl = SM.getLocForStartOfFile(SM.getMainFileID());
     }
-    clang::FullSourceLoc fullSL(sl, SM);
-    ct::Replacement Rep(SM, sl, 0, "\n#include <hip/hip_runtime.h>\n");
-    insertReplacement(Rep, fullSL);
+    insertReplacement(sl, 0, "\n#include <hip/hip_runtime.h>\n");
   }
+  applyReplacements();
   clang::ASTFrontendAction::EndSourceFileAction();
 }
 
@@ -720,6 +1027,19 @@ public:
 
 bool HipifyAction::BeginInvocation(clang::CompilerInstance &CI) {
   llcompat::RetainExcludedConditionalBlocks(CI);
+  llcompat::SkipFunctionBodies(CI);
+  return true;
+}
+
+#if LLVM_VERSION_MAJOR < 5
+bool HipifyAction::BeginSourceFileAction(clang::CompilerInstance &CI, StringRef Filename) {
+#else
+bool HipifyAction::BeginSourceFileAction(clang::CompilerInstance &CI) {
+#endif
+  // The main file buffer is already loaded by the SourceManager: count it here rather than in ExecuteAction,
+  // so that the totals of the statistics are there even if the action doesn't get to execute.
+  auto &SM = CI.getSourceManager();
+  Statistics::current().setSource(SM.getBufferData(SM.getMainFileID()));
   return true;
 }
 
@@ -746,11 +1066,11 @@ void HipifyAction::ExecuteAction() {
 }
 
 void HipifyAction::run(const mat::MatchFinder::MatchResult &Result) {
-  if (cudaLaunchKernel(Result)) return;
-  if (cudaSharedIncompleteArrayVar(Result)) return;
-  if (cudaHostFuncCall(Result)) return;
-  if (cudaDeviceFuncCall(Result)) return;
-  if (cubNamespacePrefix(Result)) return;
-  if (cubFunctionTemplateDecl(Result)) return;
-  if (cubUsingNamespaceDecl(Result)) return;
+  if (cudaLaunchKernel(Result.Nodes.getNodeAs<clang::CUDAKernelCallExpr>(sCudaLaunchKernel))) return;
+  if (cudaSharedIncompleteArrayVar(Result.Nodes.getNodeAs<clang::VarDecl>(sCudaSharedIncompleteArrayVar))) return;
+  if (cudaHostFuncCall(Result.Nodes.getNodeAs<clang::CallExpr>(sCudaHostFuncCall))) return;
+  if (cudaDeviceFuncCall(Result.Nodes.getNodeAs<clang::CallExpr>(sCudaDeviceFuncCall))) return;
+  if (cubNamespacePrefix(Result.Nodes.getNodeAs<clang::TypedefNameDecl>(sCubNamespacePrefix))) return;
+  if (cubFunctionTemplateDecl(Result.Nodes.getNodeAs<clang::FunctionTemplateDecl>(sCubFunctionTemplateDecl))) return;
+  if (cubUsingNamespaceDecl(Result.Nodes.getNodeAs<clang::UsingDirectiveDecl>(sCubUsingNamespaceDecl))) return;
 }
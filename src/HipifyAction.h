@@ -27,7 +27,11 @@ THE SOFTWARE.
 #include "clang/Tooling/Core/Replacement.h"
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/StringSaver.h"
 #include "ReplacementsFrontendActionFactory.h"
+#include "SortedMap.h"
 #include "Statistics.h"
 
 namespace ct = clang::tooling;
@@ -40,9 +44,27 @@ using namespace llvm;
 class HipifyAction : public clang::ASTFrontendAction,
                      public mat::MatchFinder::MatchCallback {
 private:
+  // A Replacement, which is not yet added to replacements; the file is an index in replacementFileLocs.
+  struct PendingReplacement {
+    unsigned fileIndex;
+    unsigned offset;
+    unsigned length;
+    unsigned order;
+    StringRef text;
+  };
   ct::Replacements *replacements;
+  // Replacements are collected while hipifying and added to replacements all at once in EndSourceFileAction().
+  std::vector<PendingReplacement> pendingReplacements;
+  // A location in each of the files being replaced, to compute the file path from only once per file.
+  llvm::DenseMap<clang::FileID, unsigned> replacementFiles;
+  std::vector<clang::SourceLocation> replacementFileLocs;
+  llvm::BumpPtrAllocator replacementTextAllocator;
+  llvm::StringSaver replacementTextSaver{replacementTextAllocator};
   std::map<std::string, clang::SourceLocation> Ifndefs;
   std::unique_ptr<mat::MatchFinder> Finder;
+  // Per matcher callbacks and time records, used only with -print-matcher-profile.
+  std::vector<std::unique_ptr<mat::MatchFinder::MatchCallback>> ProfilingCallbacks;
+  llvm::StringMap<llvm::TimeRecord> MatcherTimeRecords;
   // CUDA implicitly adds its runtime header. We rewrite explicitly-provided CUDA includes with equivalent
   // ones, and track - using this flag - if the result led to us including the hip runtime header. If it did
   // not, we insert it at the top of the file when we finish processing it.
@@ -65,18 +87,20 @@ private:
   void RewriteToken(const clang::Token &t);
   // Calculate str's SourceLocation in SourceRange sr
   clang::SourceLocation GetSubstrLocation(const std::string &str, const clang::SourceRange &sr);
+  // Get the MatchCallback for the named matcher: either this or a profiling one.
+  mat::MatchFinder::MatchCallback *getMatchCallback(StringRef matcherName);
 
 public:
   explicit HipifyAction(ct::Replacements *replacements): clang::ASTFrontendAction(),
     replacements(replacements) {}
-  // MatchCallback listeners
-  bool cudaLaunchKernel(const mat::MatchFinder::MatchResult &Result);
-  bool cudaSharedIncompleteArrayVar(const mat::MatchFinder::MatchResult &Result);
-  bool cudaDeviceFuncCall(const mat::MatchFinder::MatchResult &Result);
-  bool cudaHostFuncCall(const mat::MatchFinder::MatchResult &Result);
-  bool cubNamespacePrefix(const mat::MatchFinder::MatchResult &Result);
-  bool cubFunctionTemplateDecl(const mat::MatchFinder::MatchResult &Result);
-  bool cubUsingNamespaceDecl(const mat::MatchFinder::MatchResult &Result);
+  // AST node listeners, called either by run() for the matched nodes or by the AST visitor (-use-ast-visitor)
+  bool cudaLaunchKernel(const clang::CUDAKernelCallExpr *launchKernel);
+  bool cudaSharedIncompleteArrayVar(const clang::VarDecl *sharedVar);
+  bool cudaDeviceFuncCall(const clang::CallExpr *call);
+  bool cudaHostFuncCall(const clang::CallExpr *call);
+  bool cubNamespacePrefix(const clang::TypedefNameDecl *decl);
+  bool cubFunctionTemplateDecl(const clang::FunctionTemplateDecl *decl);
+  bool cubUsingNamespaceDecl(const clang::UsingDirectiveDecl *decl);
   // Called by the preprocessor for each include directive during the non-raw lexing pass.
   void InclusionDirective(clang::SourceLocation hash_loc,
                           const clang::Token &include_token,
@@ -94,17 +118,30 @@ public:
   void Ifndef(clang::SourceLocation Loc, const clang::Token &MacroNameTok, const clang::MacroDefinition &MD);
 
 protected:
+  // Count the reference to the CUDA name in the statistics and, with -emit-usage-index, record its location.
+  void countReference(const hipCounter &counter, StringRef name, clang::SourceLocation sl);
   // Add a Replacement for the current file. These will all be applied after executing the FrontendAction.
-  void insertReplacement(const ct::Replacement &rep, const clang::FullSourceLoc &fullSL);
+  void insertReplacement(clang::SourceLocation sl, unsigned length, StringRef text);
+  // Sort and conflict-check all the collected replacements and add them to replacements.
+  void applyReplacements();
   // FrontendAction entry point.
   void ExecuteAction() override;
   // Callback before starting processing a single input; used by hipify-clang for setting Preprocessor options.
   bool BeginInvocation(clang::CompilerInstance &CI) override;
+  // Callback after the main file is loaded, before parsing it; used for counting its bytes and lines.
+#if LLVM_VERSION_MAJOR < 5
+  bool BeginSourceFileAction(clang::CompilerInstance &CI, StringRef Filename) override;
+#else
+  bool BeginSourceFileAction(clang::CompilerInstance &CI) override;
+#endif
   // Called at the start of each new file to process.
   void EndSourceFileAction() override;
   // MatchCallback API entry point. Called by the AST visitor while searching the AST for things we registered an interest for.
   void run(const mat::MatchFinder::MatchResult &Result) override;
   std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance &CI, StringRef InFile) override;
   bool Exclude(const hipCounter &hipToken);
-  void FindAndReplace(StringRef name, clang::SourceLocation sl, const std::map<StringRef, hipCounter> &repMap, bool bReplace = true);
+  void FindAndReplace(StringRef name, clang::SourceLocation sl, const SortedMap<StringRef, hipCounter> &repMap, bool bReplace = true);
+  void FindAndReplace(StringRef name, clang::SourceLocation sl, const SortedMap<StringRef, const hipCounter*> &repMap, bool bReplace = true);
+  // Count, warn about and, if bReplace, replace the CUDA identifier name, found in a map.
+  void ReplaceIdentifier(StringRef name, clang::SourceLocation sl, const hipCounter &counter, bool bReplace);
 };
@@ -0,0 +1,576 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "llvm/Support/MemoryBuffer.h"
+#include "HipifyLex.h"
+#include "ArgParse.h"
+#include "LLVMCompat.h"
+#include "Statistics.h"
+
+using namespace llvm;
+
+namespace lex {
+
+namespace {
+
+const StringRef sCudaLaunchKernel = "cudaLaunchKernel";
+const StringRef sHipLaunchKernelGGL = "hipLaunchKernelGGL";
+const StringRef sHIP_KERNEL_NAME = "HIP_KERNEL_NAME";
+const StringRef sHipRuntimeInclude = "#include \"hip/hip_runtime.h\"";
+const StringRef sCub = "cub";
+const std::string sHIP = "HIP";
+const std::string sROC = "ROC";
+const hipCounter launchCounter = {sHipLaunchKernelGGL, "", CONV_KERNEL_LAUNCH, API_RUNTIME};
+
+enum CharKind : unsigned char {
+  // Whitespace and punctuation, which are copied as is.
+  CHAR_OTHER = 0,
+  CHAR_IDENTIFIER = 1,
+  CHAR_DIGIT = 2,
+  // The characters, which may start a literal, a comment, a directive or a kernel launch: " ' / # <
+  CHAR_SPECIAL = 4,
+  // The first characters of the CUDA names.
+  CHAR_CUDA_NAME = 8
+};
+
+/**
+  * The kinds of the characters and the bounds of the CUDA names, computed once from the mappings: an identifier,
+  * which doesn't start with the first character of any CUDA name or is longer than all of them, is not looked up.
+  */
+struct CharKinds {
+  unsigned char kinds[256] = {};
+  size_t maxNameLength = 0;
+
+  CharKinds() {
+    for (unsigned c = 'a'; c <= 'z'; ++c) kinds[c] = CHAR_IDENTIFIER;
+    for (unsigned c = 'A'; c <= 'Z'; ++c) kinds[c] = CHAR_IDENTIFIER;
+    for (unsigned c = '0'; c <= '9'; ++c) kinds[c] = CHAR_DIGIT;
+    kinds[(unsigned char)'_'] = CHAR_IDENTIFIER;
+    kinds[(unsigned char)'$'] = CHAR_IDENTIFIER;
+    for (char c : {'"', '\'', '/', '#', '<'}) kinds[(unsigned char)c] = CHAR_SPECIAL;
+    for (const auto &m : CUDA_RENAMES_MAP()) addName(m.first);
+    for (const auto &m : CUDA_DEVICE_FUNC_MAP) addName(m.first);
+    addName(sCub);
+  }
+
+  void addName(StringRef name) {
+    if (name.empty()) return;
+    kinds[(unsigned char)name[0]] |= CHAR_CUDA_NAME;
+    maxNameLength = std::max(maxNameLength, name.size());
+  }
+};
+
+const CharKinds &getCharKinds() {
+  static const CharKinds charKinds;
+  return charKinds;
+}
+
+bool isIdentifierChar(char c) {
+  return getCharKinds().kinds[(unsigned char)c] & (CHAR_IDENTIFIER | CHAR_DIGIT);
+}
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+StringRef trim(StringRef s) {
+  return s.trim(" \t\n\r\f\v");
+}
+
+// Find the closing quote of the literal, which starts at p, or the end of its line for an unterminated one.
+const char *skipLiteral(const char *p, const char *end) {
+  const char quote = *p++;
+  while (p < end) {
+    const char *q = static_cast<const char*>(std::memchr(p, quote, end - p));
+    const char *eol = static_cast<const char*>(std::memchr(p, '\n', (q ? q : end) - p));
+    if (eol) return eol;
+    if (!q) return end;
+    // The quote is escaped by an odd number of backslashes.
+    const char *b = q;
+    while (b > p && b[-1] == '\\') --b;
+    p = q + 1;
+    if ((q - b) % 2 == 0) return p;
+  }
+  return end;
+}
+
+class Scanner {
+  const char *source;
+  Result &result;
+  // Whether __global__ or __shared__ are met: the file has device code.
+  bool hasDeviceCode = false;
+  unsigned launches = 0;
+  // The line of the position `counted` for computing the lines of the matches incrementally.
+  const char *counted;
+  const char *countedLineStart;
+  unsigned countedLine = 1;
+  // The previous identifier for the 'namespace cub' check.
+  StringRef previousIdentifier;
+
+  void getLineAndColumn(const char *p, unsigned &line, unsigned &column) {
+    if (p < counted) {
+      counted = countedLineStart = source;
+      countedLine = 1;
+    }
+    unsigned lines = countNewLines(StringRef(counted, p - counted));
+    if (lines) {
+      countedLine += lines;
+      for (countedLineStart = p; countedLineStart[-1] != '\n'; --countedLineStart) {}
+    }
+    counted = p;
+    line = countedLine;
+    column = unsigned(p - countedLineStart) + 1;
+  }
+
+  void addMatch(const hipCounter &counter, StringRef name, const char *p, unsigned length) {
+    Match match = {&counter, name, 0, 0, length};
+    getLineAndColumn(p, match.line, match.column);
+    result.matches.push_back(match);
+  }
+
+  // Copy the source up to p to out and append the replacement, skipping the source up to `to`.
+  static void replace(std::string &out, const char *&copied, const char *p, const char *to, StringRef replacement) {
+    out.append(copied, p);
+    out.append(replacement.data(), replacement.size());
+    copied = to;
+  }
+
+  void identifier(std::string &out, const char *&copied, const char *p, const char *end, const char *q, bool inLiteral) {
+    StringRef name(p, q - p);
+    StringRef previous = previousIdentifier;
+    if (!inLiteral) {
+      previousIdentifier = name;
+      if (name == "__global__" || name == "__shared__") {
+        hasDeviceCode = true;
+        return;
+      }
+    }
+    const CharKinds &charKinds = getCharKinds();
+    if (!(charKinds.kinds[(unsigned char)*p] & CHAR_CUDA_NAME) || name.size() > charKinds.maxNameLength) return;
+    const auto found = CUDA_RENAMES_MAP().find(name);
+    if (found != CUDA_RENAMES_MAP().end()) {
+      const hipCounter &counter = *found->second;
+      const bool unsupported = Statistics::isUnsupported(counter);
+      addMatch(counter, found->first, p, unsupported ? 0 : unsigned(name.size()));
+      if (!unsupported) {
+        replace(out, copied, p, q, Statistics::isToRoc(counter) ? counter.rocName : counter.hipName);
+      }
+      return;
+    }
+    if (inLiteral) return;
+    // cub as a namespace: cub:: or namespace cub
+    if (name == sCub) {
+      if ((q + 1 < end && q[0] == ':' && q[1] == ':') || previous == "namespace") {
+        const auto cub = CUDA_CUB_TYPE_NAME_MAP.find(sCub);
+        if (cub != CUDA_CUB_TYPE_NAME_MAP.end()) replace(out, copied, p, q, cub->second.hipName);
+      }
+      return;
+    }
+    // A device function is counted, if called and not qualified by a namespace.
+    const auto func = CUDA_DEVICE_FUNC_MAP.find(name);
+    if (func == CUDA_DEVICE_FUNC_MAP.end()) return;
+    const char *r = q;
+    while (r < end && isSpace(*r)) ++r;
+    if (r == end || *r != '(' || (p - source > 1 && p[-1] == ':' && p[-2] == ':')) return;
+    addMatch(func->second, func->first, p, 0);
+  }
+
+  // Rename the identifiers in the literal [p, q).
+  void literal(std::string &out, const char *&copied, const char *p, const char *q) {
+    const unsigned char *kinds = getCharKinds().kinds;
+    while (p < q) {
+      if (!(kinds[(unsigned char)*p] & (CHAR_IDENTIFIER | CHAR_DIGIT))) {
+        ++p;
+        continue;
+      }
+      const char *r = p;
+      while (r < q && isIdentifierChar(*r)) ++r;
+      if (kinds[(unsigned char)*p] & CHAR_IDENTIFIER) identifier(out, copied, p, q, r, true);
+      p = r;
+    }
+  }
+
+  // Rename the header of the include directive, which starts at p, and return the end of the directive.
+  const char *include(std::string &out, const char *&copied, const char *hash, const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    if (p == end || (*p != '<' && *p != '"')) return p;
+    const char close = *p == '<' ? '>' : '"';
+    const char *header = ++p;
+    while (p < end && *p != close && *p != '\n') ++p;
+    if (p == end || *p != close) return p;
+    StringRef name(header, p - header);
+    const auto found = CUDA_INCLUDE_MAP.find(name);
+    if (found == CUDA_INCLUDE_MAP.end()) return p + 1;
+    const hipCounter &counter = found->second;
+    const bool unsupported = Statistics::isUnsupported(counter);
+    StringRef newName = Statistics::isToRoc(counter) ? counter.rocName : counter.hipName;
+    if (unsupported) {
+      addMatch(counter, found->first, header, 0);
+    } else if (newName.empty()) {
+      // A header without a HIP counterpart: remove the directive.
+      addMatch(counter, found->first, header, unsigned(p + 1 - hash));
+      replace(out, copied, hash, p + 1, "");
+    } else {
+      addMatch(counter, found->first, header, unsigned(name.size()));
+      replace(out, copied, header, p, newName);
+    }
+    return p + 1;
+  }
+
+  /**
+    * Rewrite the kernel launch kern<...><<<Dg, Db[, Ns[, S]]>>>(...), whose <<< is at p, with hipLaunchKernelGGL, as
+    * hipify-perl does, and return the position after the opening parenthesis of the args, or null if it is not a
+    * kernel launch. The kernel name and its template args are looked for in `out`, already hipified, after `floor`.
+    */
+  const char *launch(std::string &out, const char *&copied, size_t &floor, const char *p, const char *end) {
+    // The launch configuration, split at the commas outside of brackets and literals, up to >>>
+    std::vector<StringRef> config;
+    const char *arg = p + 3, *q = p + 3;
+    int depth = 0;
+    for (;; ++q) {
+      if (q == end) return nullptr;
+      const char c = *q;
+      if (c == '"' || c == '\'') {
+        q = skipLiteral(q, end) - 1;
+      } else if (c == '(' || c == '[' || c == '{') {
+        ++depth;
+      } else if (c == ')' || c == ']' || c == '}') {
+        if (depth-- == 0) return nullptr;
+      } else if (depth == 0 && c == ',') {
+        config.push_back(trim(StringRef(arg, q - arg)));
+        arg = q + 1;
+      } else if (depth == 0 && c == '>' && q + 2 < end && q[1] == '>' && q[2] == '>') {
+        config.push_back(trim(StringRef(arg, q - arg)));
+        q += 3;
+        break;
+      }
+    }
+    if (config.size() < 2 || config.size() > 4) return nullptr;
+    for (const auto &c : config) {
+      if (c.empty()) return nullptr;
+    }
+    // The args: empty ones are closed right away
+    while (q < end && isSpace(*q)) ++q;
+    if (q == end || *q != '(') return nullptr;
+    const char *args = ++q;
+    while (q < end && isSpace(*q)) ++q;
+    const bool noArgs = q < end && *q == ')';
+    if (noArgs) args = q + 1;
+    // The kernel name with the optional template args, which end right before <<<
+    out.append(copied, p);
+    copied = p;
+    size_t begin = out.size();
+    while (begin > floor && isSpace(out[begin - 1])) --begin;
+    const size_t templateEnd = begin;
+    if (begin > floor && out[begin - 1] == '>') {
+      int templateDepth = 0;
+      while (begin > floor) {
+        const char c = out[--begin];
+        if (c == '>' || c == ')') {
+          ++templateDepth;
+        } else if ((c == '<' || c == '(') && --templateDepth == 0) {
+          break;
+        }
+      }
+      if (templateDepth) return nullptr;
+      while (begin > floor && isSpace(out[begin - 1])) --begin;
+    }
+    const size_t templateBegin = begin;
+    while (begin > floor && (out[begin - 1] == ':' || isIdentifierChar(out[begin - 1]))) --begin;
+    if (begin == templateBegin) return nullptr;
+    std::string replacement = sHipLaunchKernelGGL.str() + "(";
+    if (templateBegin != templateEnd) {
+      replacement += sHIP_KERNEL_NAME.str() + "(" + out.substr(begin, templateBegin - begin) + "<" +
+                     out.substr(templateBegin + 1, templateEnd - templateBegin - 2) + ">)";
+    } else {
+      replacement += out.substr(begin, templateBegin - begin);
+    }
+    // The position of the launch is taken before its configuration is scanned, as the names in it move `counted` past p.
+    Match match = {&launchCounter, sCudaLaunchKernel, 0, 0, 0};
+    getLineAndColumn(p, match.line, match.column);
+    for (size_t i = 0; i < 4; ++i) {
+      std::string hipified;
+      if (i < config.size()) {
+        scan(config[i].data(), config[i].data() + config[i].size(), hipified);
+      } else {
+        hipified = "0";
+      }
+      replacement += i < 2 ? ", dim3(" + hipified + ")" : ", " + hipified;
+    }
+    replacement += noArgs ? ")" : ", ";
+    match.length = unsigned(out.size() - begin + (args - p));
+    result.matches.push_back(match);
+    ++launches;
+    out.resize(begin);
+    out += replacement;
+    copied = args;
+    floor = out.size();
+    return args;
+  }
+
+public:
+  Scanner(StringRef src, Result &res): source(src.data()), result(res), counted(src.data()), countedLineStart(src.data()) {}
+
+  // Hipify the source [p, end), appending it to out.
+  void scan(const char *p, const char *end, std::string &out) {
+    const unsigned char *kinds = getCharKinds().kinds;
+    const char *copied = p;
+    size_t floor = out.size();
+    while (p < end) {
+      const unsigned char kind = kinds[(unsigned char)*p];
+      if (kind == CHAR_OTHER) {
+        ++p;
+        continue;
+      }
+      if (kind & CHAR_IDENTIFIER) {
+        const char *q = p + 1;
+        while (q < end && isIdentifierChar(*q)) ++q;
+        identifier(out, copied, p, end, q, false);
+        p = q;
+        continue;
+      }
+      if (kind & CHAR_DIGIT) {
+        // A number with its suffix, exponent and digit separators, so that 1e5f or 0x1cu are not identifiers.
+        const char *q = p + 1;
+        while (q < end && (isIdentifierChar(*q) || *q == '.' || *q == '\'' ||
+               ((*q == '+' || *q == '-') && (q[-1] == 'e' || q[-1] == 'E' || q[-1] == 'p' || q[-1] == 'P')))) ++q;
+        p = q;
+        continue;
+      }
+      switch (*p) {
+        case '"': {
+          const char *q = skipLiteral(p, end);
+          literal(out, copied, p + 1, q);
+          p = q;
+          break;
+        }
+        case '\'':
+          p = skipLiteral(p, end);
+          break;
+        case '/':
+          if (p + 1 < end && p[1] == '/') {
+            const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            p = eol ? eol : end;
+          } else if (p + 1 < end && p[1] == '*') {
+            StringRef rest(p + 2, end - p - 2);
+            size_t close = rest.find("*/");
+            p = close == StringRef::npos ? end : rest.data() + close + 2;
+          } else {
+            ++p;
+          }
+          break;
+        case '#': {
+          // A directive: # is the first non-space character of its line.
+          const char *b = p;
+          while (b > source && (b[-1] == ' ' || b[-1] == '\t')) --b;
+          const char *q = p + 1;
+          if (b == source || b[-1] == '\n') {
+            while (q < end && (*q == ' ' || *q == '\t')) ++q;
+            StringRef directive(q, end - q);
+            if (directive.startswith("include") && (directive.size() == 7 || !isIdentifierChar(directive[7]))) {
+              q = include(out, copied, p, q + 7, end);
+            }
+          }
+          p = q;
+          break;
+        }
+        case '<':
+          if (p + 2 < end && p[1] == '<' && p[2] == '<') {
+            const char *q = launch(out, copied, floor, p, end);
+            p = q ? q : p + 1;
+          } else {
+            ++p;
+          }
+          break;
+        default:
+          ++p;
+          break;
+      }
+    }
+    out.append(copied, end);
+  }
+
+  // Hipify the whole source into the result.
+  void scan() {
+    StringRef src(source, result.totalBytes);
+    scan(src.begin(), src.end(), result.output);
+    // As hipify-perl does, the supported device functions are counted in the sources with device code only.
+    if (!hasDeviceCode) {
+      auto &matches = result.matches;
+      matches.erase(std::remove_if(matches.begin(), matches.end(), [](const Match &m) {
+        return m.counter->type == CONV_DEVICE_FUNC && !Statistics::isUnsupported(*m.counter);
+      }), matches.end());
+    }
+    // As hipify-perl does, the HIP runtime header is added to the converted sources with device code or kernel launches.
+    bool converted = false;
+    for (const auto &m : result.matches) {
+      if (m.length) {
+        converted = true;
+        break;
+      }
+    }
+    if (converted && (hasDeviceCode || launches)) {
+      const bool dos = src.endswith("\r\n");
+      result.output.insert(0, sHipRuntimeInclude.str() + (dos ? "\r\n" : "\n"));
+    }
+  }
+};
+
+// The hipification of a source file on a worker thread, reported on the main thread in the order of the files.
+struct FileResult {
+  // The statistics of the file, collected on the worker thread as its active ones.
+  std::unique_ptr<Statistics> stat;
+  // The warnings, buffered so that they are not interleaved with the ones of the other files.
+  std::string warnings;
+  std::string error;
+};
+
+void warn(raw_ostream &warnings, const std::string &fileName, const Match &match, const Twine &message) {
+  warnings << fileName << ":" << match.line << ":" << match.column << ": " << sWarning << message << "\n";
+}
+
+// Count the matches of the file in the active statistics and write the warnings as hipify-clang does.
+void report(const std::string &fileName, const Result &result, raw_ostream &warnings) {
+  Statistics &stat = Statistics::current();
+  stat.setSource(result.totalBytes, result.totalLines);
+  for (const auto &m : result.matches) {
+    const hipCounter &counter = *m.counter;
+    stat.incrementCounter(counter, m.name.str());
+    if (Statistics::isUsageIndexed()) stat.recordUsage(counter, m.name.str(), m.line, m.column);
+    if (Statistics::isDeprecated(counter)) warn(warnings, fileName, m, "CUDA identifier is deprecated.");
+    if (Statistics::isRemoved(counter)) warn(warnings, fileName, m, "CUDA identifier is removed.");
+    if (Statistics::isUnsupported(counter)) {
+      if (counter.type == CONV_INCLUDE || counter.type == CONV_INCLUDE_CUDA_MAIN_H) {
+        warn(warnings, fileName, m, "Unsupported CUDA header.");
+      } else {
+        warn(warnings, fileName, m, "CUDA identifier is unsupported in " + (Statistics::isToRoc(counter) ? sROC : sHIP) + ".");
+      }
+    }
+    if (m.length) {
+      stat.lineTouched(m.line);
+      stat.bytesChanged(m.length);
+    }
+  }
+  stat.markCompletion();
+}
+
+void hipifyFile(const std::string &src, const std::string &dst, Result &result) {
+  // The file is memory mapped, unless it is small.
+  ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFile(src);
+  if (!buffer) {
+    result.error = buffer.getError().message() + ": while reading " + src;
+    return;
+  }
+  hipify((*buffer)->getBuffer(), result);
+  // The source is released before writing the output, which might be the source itself with -inplace.
+  buffer->reset();
+  if (dst.empty()) return;
+  std::ofstream output(dst, std::ios_base::binary | std::ios_base::trunc);
+  output.write(result.output.data(), result.output.size());
+  if (!output) result.error = "while writing " + dst;
+}
+
+// Hipify the source file into the destination one and collect its statistics and warnings on the calling thread.
+void hipifyFile(const std::string &src, const std::string &dst, FileResult &fileResult) {
+  std::unique_ptr<Statistics> stat(new Statistics(src));
+  Result result;
+  hipifyFile(src, dst, result);
+  if (!result.error.empty()) {
+    fileResult.error = result.error;
+    return;
+  }
+  Statistics::setActive(stat.get());
+  raw_string_ostream warnings(fileResult.warnings);
+  report(src, result, warnings);
+  warnings.flush();
+  Statistics::setActive(nullptr);
+  fileResult.stat = std::move(stat);
+}
+
+} // anonymous namespace
+
+void hipify(StringRef source, Result &result) {
+  result.totalBytes = unsigned(source.size());
+  result.totalLines = countNewLines(source);
+  result.output.reserve(source.size() + source.size() / 16);
+  Scanner(source, result).scan();
+}
+
+bool hipify(const std::vector<std::string> &sources, const std::vector<std::string> &destinations, unsigned jobs,
+            std::ostream *csv, llvm::raw_ostream *printOut) {
+  // The mappings are built and the characters are classified before starting the threads.
+  getCharKinds();
+  const size_t count = sources.size();
+  std::vector<FileResult> results(count);
+  std::vector<bool> done(count, false);
+  std::mutex doneMutex;
+  std::condition_variable doneCondition;
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      hipifyFile(sources[i], destinations[i], results[i]);
+      std::lock_guard<std::mutex> lock(doneMutex);
+      done[i] = true;
+      doneCondition.notify_all();
+    }
+  };
+  unsigned threadCount = jobs ? jobs : std::thread::hardware_concurrency();
+  threadCount = unsigned(std::max<size_t>(1, std::min<size_t>(threadCount, count)));
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < threadCount; ++i) {
+    threads.emplace_back(worker);
+  }
+  bool ret = true;
+  // The files are reported in order, as soon as each of them is done, and their statistics are folded into the
+  // aggregate.
+  for (size_t i = 0; i < count; ++i) {
+    {
+      std::unique_lock<std::mutex> lock(doneMutex);
+      doneCondition.wait(lock, [&]() { return done[i]; });
+    }
+    FileResult &result = results[i];
+    if (!result.error.empty()) {
+      llvm::errs() << "\n" << sHipify << sError << result.error << "\n";
+      ret = false;
+      continue;
+    }
+    llvm::errs() << result.warnings;
+    std::string().swap(result.warnings);
+    Statistics::addFile(std::move(*result.stat)).print(csv, printOut);
+    result.stat.reset();
+    Statistics::fold(sources[i]);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  return ret;
+}
+
+}
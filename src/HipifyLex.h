@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+#include "CUDA2HIP.h"
+
+/**
+  * hipify-lex: the clang-free hipification engine of hipify-clang -lex.
+  *
+  * The sources are not parsed: each of them is scanned once as a sequence of identifiers, numbers, literals,
+  * comments, include directives and kernel launches, and hipified with the same mappings as hipify-clang does,
+  * but by the same rules as hipify-perl: every CUDA identifier outside comments, string literals included, is
+  * renamed, the headers of the include directives are renamed, kern<<<...>>>(...) launches are rewritten with
+  * hipLaunchKernelGGL, and cub is renamed as a namespace.
+  */
+namespace lex {
+
+  // A CUDA identifier, header or kernel launch found in a source file.
+  struct Match {
+    const hipCounter *counter;
+    // The CUDA name; refers to the mappings, not to the source.
+    llvm::StringRef name;
+    unsigned line;
+    unsigned column;
+    // The count of bytes of the source replaced, 0 if not replaced.
+    unsigned length;
+  };
+
+  // The result of hipifying a source file.
+  struct Result {
+    std::string output;
+    std::vector<Match> matches;
+    unsigned totalBytes = 0;
+    unsigned totalLines = 0;
+    // An error message, if the source could not be read or the output could not be written.
+    std::string error;
+  };
+
+  // Hipify the source text.
+  void hipify(llvm::StringRef source, Result &result);
+
+  /**
+    * Hipify the source files into the corresponding destination files (none with -no-output) on `jobs` threads,
+    * all the hardware threads if 0. The statistics, the warnings and the errors are reported in the order of the
+    * files, as each of them is done, the statistics to csv and printOut, if not null.
+    */
+  bool hipify(const std::vector<std::string> &sources, const std::vector<std::string> &destinations, unsigned jobs,
+              std::ostream *csv, llvm::raw_ostream *printOut);
+}
@@ -88,6 +88,14 @@ clang::SourceLocation getBeginLoc(const clang::TypeLoc &typeLoc) {
 #endif
 }
 
+clang::SourceLocation getBeginLoc(const clang::Decl *decl) {
+#if LLVM_VERSION_MAJOR < 8
+  return decl->getLocStart();
+#else
+  return decl->getBeginLoc();
+#endif
+}
+
 clang::SourceLocation getEndLoc(const clang::Stmt *stmt) {
 #if LLVM_VERSION_MAJOR < 8
   return stmt->getLocEnd();
@@ -139,6 +147,11 @@ bool CheckCompatibility() {
   if (SkipExcludedPPConditionalBlocks) {
     llvm::errs() << "\n" << sHipify << sWarning << "Option '" << SkipExcludedPPConditionalBlocks.ArgStr.str() << "' is supported starting from LLVM version 10.0\n";
   }
+#endif
+#if (LLVM_VERSION_MAJOR == 3) && (LLVM_VERSION_MINOR == 8)
+  if (SkipFunctionBodiesOutsideMainFile) {
+    llvm::errs() << "\n" << sHipify << sWarning << "Option '" << SkipFunctionBodiesOutsideMainFile.ArgStr.str() << "' is supported starting from LLVM version 3.9\n";
+  }
 #endif
   return true;
 }
@@ -159,4 +172,17 @@ Memory_Buffer getMemoryBuffer(const clang::SourceManager &SM) {
 #endif
 }
 
+void SkipFunctionBodies(clang::CompilerInstance &CI) {
+#if !((LLVM_VERSION_MAJOR == 3) && (LLVM_VERSION_MINOR == 8))
+  // Function bodies are skipped only for declarations, for which ASTConsumer::shouldSkipFunctionBody() returns true.
+  CI.getFrontendOpts().SkipFunctionBodies = SkipFunctionBodiesOutsideMainFile;
+#endif
+}
+
+void setTraversalScope(clang::ASTContext &Context, const std::vector<clang::Decl*> &TopLevelDecls) {
+#if LLVM_VERSION_MAJOR >= 8
+  Context.setTraversalScope(TopLevelDecls);
+#endif
+}
+
 } // namespace llcompat
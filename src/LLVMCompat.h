@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include <llvm/Support/Signals.h>
 #include <clang/Lex/Token.h>
 #include <clang/Lex/Preprocessor.h>
+#include <clang/AST/ASTContext.h>
 
 namespace ct = clang::tooling;
 
@@ -51,6 +52,7 @@ namespace llcompat {
 
 clang::SourceLocation getBeginLoc(const clang::Stmt *stmt);
 clang::SourceLocation getBeginLoc(const clang::TypeLoc &typeLoc);
+clang::SourceLocation getBeginLoc(const clang::Decl *decl);
 
 clang::SourceLocation getEndLoc(const clang::Stmt *stmt);
 clang::SourceLocation getEndLoc(const clang::TypeLoc &typeLoc);
@@ -87,6 +89,8 @@ bool pragma_once_outside_header();
 
 void RetainExcludedConditionalBlocks(clang::CompilerInstance &CI);
 
+void SkipFunctionBodies(clang::CompilerInstance &CI);
+
 bool CheckCompatibility();
 
 clang::SourceLocation getEndOfExpansionRangeForLoc(const clang::SourceManager &SM, const clang::SourceLocation &loc);
@@ -99,4 +103,12 @@ clang::SourceLocation getEndOfExpansionRangeForLoc(const clang::SourceManager &S
 
 Memory_Buffer getMemoryBuffer(const clang::SourceManager &SM);
 
+/**
+  * Restrict the AST traversal to the given top-level declarations.
+  *
+  * ASTContext::setTraversalScope() appeared in clang 8.0; on older versions the whole translation unit
+  * is traversed as before.
+  */
+void setTraversalScope(clang::ASTContext &Context, const std::vector<clang::Decl*> &TopLevelDecls);
+
 } // namespace llcompat
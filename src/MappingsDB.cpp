@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <cstring>
+#include "MappingsDB.h"
+
+const char MappingsDB::Magic[8] = {'H', 'I', 'P', 'I', 'F', 'Y', 'D', 'B'};
+const char *const MappingsDB::FileName = "hipify-mappings.db";
+
+namespace {
+
+// The names should be in the string pool, the CUDA one is not empty; the kind and the types are indices in the tables.
+bool isValidEntry(const mappingsDBEntry &e, uint32_t stringsSize) {
+  return e.cudaNameSize != 0 &&
+         uint64_t(e.cudaName) + e.cudaNameSize <= stringsSize &&
+         uint64_t(e.hipName) + e.hipNameSize <= stringsSize &&
+         uint64_t(e.rocName) + e.rocNameSize <= stringsSize &&
+         e.kind < uint32_t(MAPPING_LAST) &&
+         e.type < uint32_t(NUM_CONV_TYPES) &&
+         e.apiType < uint32_t(NUM_API_TYPES);
+}
+
+}
+
+MappingsDB::MappingsDB(std::unique_ptr<llvm::MemoryBuffer> buffer): buffer(std::move(buffer)) {}
+
+std::unique_ptr<MappingsDB> MappingsDB::open(llvm::StringRef path, std::string &error) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    error = buffer.getError().message() + ": " + path.str();
+    return nullptr;
+  }
+  return create(std::move(buffer.get()), error);
+}
+
+std::unique_ptr<MappingsDB> MappingsDB::create(std::unique_ptr<llvm::MemoryBuffer> buffer, std::string &error) {
+  const char *start = buffer->getBufferStart();
+  const uint64_t size = buffer->getBufferSize();
+  if (size < sizeof(mappingsDBHeader) || std::memcmp(start, Magic, sizeof(Magic)) != 0) {
+    error = "not a mappings database: " + buffer->getBufferIdentifier().str();
+    return nullptr;
+  }
+  const mappingsDBHeader *header = reinterpret_cast<const mappingsDBHeader*>(start);
+  if (header->version != Version) {
+    error = "unsupported mappings database version " + std::to_string(header->version) + ": " + buffer->getBufferIdentifier().str();
+    return nullptr;
+  }
+  const uint64_t entriesEnd = uint64_t(header->entriesOffset) + uint64_t(header->entryCount) * sizeof(mappingsDBEntry);
+  const uint64_t bucketsEnd = uint64_t(header->bucketsOffset) + uint64_t(header->bucketCount) * sizeof(uint32_le);
+  const uint64_t stringsEnd = uint64_t(header->stringsOffset) + header->stringsSize;
+  // The index should have at least one empty bucket, so that the search always stops.
+  bool corrupted = entriesEnd > size || bucketsEnd > size || stringsEnd > size ||
+                   header->bucketCount <= header->entryCount || (header->bucketCount & (header->bucketCount - 1)) != 0;
+  // The entries are checked once here, so that they are used as is afterwards.
+  const mappingsDBEntry *entries = reinterpret_cast<const mappingsDBEntry*>(start + header->entriesOffset);
+  for (uint32_t i = 0; !corrupted && i < header->entryCount; ++i) {
+    corrupted = !isValidEntry(entries[i], header->stringsSize);
+  }
+  if (corrupted) {
+    error = "corrupted mappings database: " + buffer->getBufferIdentifier().str();
+    return nullptr;
+  }
+  std::unique_ptr<MappingsDB> db(new MappingsDB(std::move(buffer)));
+  db->header = header;
+  db->entries = entries;
+  db->buckets = reinterpret_cast<const uint32_le*>(start + header->bucketsOffset);
+  db->strings = start + header->stringsOffset;
+  return db;
+}
+
+const mappingsDBEntry *MappingsDB::find(llvm::StringRef cudaName, mappingKind kind) const {
+  const uint32_t mask = header->bucketCount - 1;
+  uint32_t i = hash(cudaName) & mask;
+  for (uint32_t probes = 0; probes < header->bucketCount; ++probes, i = (i + 1) & mask) {
+    const uint32_t index = buckets[i];
+    if (index == 0 || index > size()) {
+      break;
+    }
+    const mappingsDBEntry &e = entries[index - 1];
+    if (e.kind == uint32_t(kind) && getCudaName(e) == cudaName) {
+      return &e;
+    }
+  }
+  return nullptr;
+}
+
+llvm::StringRef MappingsDB::getString(uint32_t offset, uint32_t size) const {
+  if (uint64_t(offset) + size > header->stringsSize) {
+    return llvm::StringRef();
+  }
+  return llvm::StringRef(strings + offset, size);
+}
+
+hipCounter MappingsDB::getCounter(const mappingsDBEntry &e) const {
+  return {getHipName(e), getRocName(e), ConvTypes(uint32_t(e.type)), ApiTypes(uint32_t(e.apiType)), e.apiSection, e.supportDegree};
+}
+
+cudaAPIversions MappingsDB::getCudaVersions(const mappingsDBEntry &e) const {
+  cudaAPIversions ret;
+  ret.appeared = cudaVersions(uint32_t(e.cudaAppeared));
+  ret.deprecated = cudaVersions(uint32_t(e.cudaDeprecated));
+  ret.removed = cudaVersions(uint32_t(e.cudaRemoved));
+  return ret;
+}
+
+hipAPIversions MappingsDB::getHipVersions(const mappingsDBEntry &e) const {
+  hipAPIversions ret;
+  ret.appeared = hipVersions(uint32_t(e.hipAppeared));
+  ret.deprecated = hipVersions(uint32_t(e.hipDeprecated));
+  ret.removed = hipVersions(uint32_t(e.hipRemoved));
+  return ret;
+}
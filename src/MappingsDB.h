@@ -0,0 +1,140 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "Statistics.h"
+
+/**
+  * The binary CUDA to HIP mappings database, generated by hipify-clang -mappings-db.
+  *
+  * The database is meant to be memory-mapped and used in place, without any parsing: all the numbers
+  * are little-endian 32-bit integers, and all the strings are NUL-terminated. The layout is:
+  *
+  *   mappingsDBHeader
+  *   mappingsDBEntry[entryCount]  sorted by kind, then by CUDA name
+  *   uint32[bucketCount]          hash index: open addressing with linear probing by the FNV-1a hash of
+  *                                the CUDA name; 0 is an empty bucket, otherwise it is entry index + 1
+  *   char[stringsSize]            string pool; the names in the entries are offsets in it
+  */
+
+typedef llvm::support::ulittle32_t uint32_le;
+
+enum mappingKind {
+  // CUDA_RENAMES_MAP
+  MAPPING_RENAME = 0,
+  // CUDA_INCLUDE_MAP
+  MAPPING_INCLUDE,
+  // CUDA_DEVICE_FUNC_MAP
+  MAPPING_DEVICE_FUNC,
+  // CUDA_CUB_TYPE_NAME_MAP
+  MAPPING_CUB,
+  MAPPING_LAST
+};
+
+struct mappingsDBHeader {
+  char magic[8];
+  uint32_le version;
+  uint32_le entryCount;
+  uint32_le bucketCount;
+  uint32_le entriesOffset;
+  uint32_le bucketsOffset;
+  uint32_le stringsOffset;
+  uint32_le stringsSize;
+};
+
+struct mappingsDBEntry {
+  uint32_le cudaName;
+  uint32_le cudaNameSize;
+  uint32_le hipName;
+  uint32_le hipNameSize;
+  uint32_le rocName;
+  uint32_le rocNameSize;
+  uint32_le kind;
+  uint32_le type;
+  uint32_le apiType;
+  uint32_le apiSection;
+  uint32_le supportDegree;
+  uint32_le cudaAppeared;
+  uint32_le cudaDeprecated;
+  uint32_le cudaRemoved;
+  uint32_le hipAppeared;
+  uint32_le hipDeprecated;
+  uint32_le hipRemoved;
+};
+
+/**
+  * Read-only access to a loaded mappings database.
+  */
+class MappingsDB {
+public:
+  static const char Magic[8];
+  // Incremented on every incompatible change of the layout.
+  static const uint32_t Version = 1;
+  // The default name of the database file.
+  static const char *const FileName;
+
+  // Hash function of the index.
+  static uint32_t hash(llvm::StringRef name) {
+    uint32_t h = 2166136261u;
+    for (unsigned char c : name) {
+      h = (h ^ c) * 16777619u;
+    }
+    return h;
+  }
+
+  // Load the database from the file; returns nullptr and fills error in case of failure.
+  static std::unique_ptr<MappingsDB> open(llvm::StringRef path, std::string &error);
+  // Use the already loaded database; returns nullptr and fills error if the buffer is not a valid database.
+  static std::unique_ptr<MappingsDB> create(std::unique_ptr<llvm::MemoryBuffer> buffer, std::string &error);
+
+  uint32_t size() const { return header->entryCount; }
+  const mappingsDBEntry &operator[](uint32_t i) const { return entries[i]; }
+  const mappingsDBEntry *begin() const { return entries; }
+  const mappingsDBEntry *end() const { return entries + size(); }
+  // Returns nullptr if there is no mapping of the given kind for the CUDA name.
+  const mappingsDBEntry *find(llvm::StringRef cudaName, mappingKind kind = MAPPING_RENAME) const;
+
+  llvm::StringRef getCudaName(const mappingsDBEntry &e) const { return getString(e.cudaName, e.cudaNameSize); }
+  llvm::StringRef getHipName(const mappingsDBEntry &e) const { return getString(e.hipName, e.hipNameSize); }
+  llvm::StringRef getRocName(const mappingsDBEntry &e) const { return getString(e.rocName, e.rocNameSize); }
+  // The names in the returned hipCounter point to the database, so they are valid while it is alive.
+  hipCounter getCounter(const mappingsDBEntry &e) const;
+  cudaAPIversions getCudaVersions(const mappingsDBEntry &e) const;
+  hipAPIversions getHipVersions(const mappingsDBEntry &e) const;
+
+private:
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  const mappingsDBHeader *header = nullptr;
+  const mappingsDBEntry *entries = nullptr;
+  const uint32_le *buckets = nullptr;
+  const char *strings = nullptr;
+
+  explicit MappingsDB(std::unique_ptr<llvm::MemoryBuffer> buffer);
+  llvm::StringRef getString(uint32_t offset, uint32_t size) const;
+};
@@ -0,0 +1,164 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <iterator>
+#include "MappingsTable.h"
+#include "ArgParse.h"
+
+namespace {
+
+const SortedMap<llvm::StringRef, cudaAPIversions> noCudaVersions;
+const SortedMap<llvm::StringRef, hipAPIversions> noHipVersions;
+
+}
+
+const MappingsTable &MappingsTable::get() {
+  static const MappingsTable table;
+  return table;
+}
+
+MappingsTable::MappingsTable() {
+  // Driver and Runtime APIs share HIP functions and types, so their HIP versions are looked up in the maps of both.
+  const SortedMap<llvm::StringRef, hipAPIversions> *driverRuntimeHipVersions[] = {
+    &HIP_DRIVER_FUNCTION_VER_MAP,
+    &HIP_DRIVER_TYPE_NAME_VER_MAP,
+    &HIP_RUNTIME_FUNCTION_VER_MAP,
+    &HIP_RUNTIME_TYPE_NAME_VER_MAP,
+  };
+  const auto overlay = CUDA_RENAMES_OVERLAY();
+  add(overlay);
+  for (auto &table : CUDA_RENAMES_TABLES()) {
+    if (std::find(std::begin(driverRuntimeHipVersions), std::end(driverRuntimeHipVersions), &table.hipVersions) != std::end(driverRuntimeHipVersions)) {
+      add(table.map, table.cudaVersions, driverRuntimeHipVersions);
+    } else {
+      add(table.map, table.cudaVersions, &table.hipVersions);
+    }
+  }
+  add(CUDA_INCLUDE_MAP, noCudaVersions, &noHipVersions);
+  add(CUDA_DEVICE_FUNC_MAP, CUDA_DEVICE_FUNC_VER_MAP, &HIP_DEVICE_FUNC_VER_MAP);
+  add(CUDA_CUB_TYPE_NAME_MAP, CUDA_CUB_TYPE_NAME_VER_MAP, &HIP_CUB_TYPE_NAME_VER_MAP);
+  ids.resize(size());
+  for (ID id = 0; id < size(); ++id) {
+    ids[id] = id;
+  }
+  unsigned int cudaVersion = 0, hipVersion = 0;
+  Statistics::parseVersion(TargetCudaVersion, cudaVersion);
+  Statistics::parseVersion(TargetHipVersion, hipVersion);
+  target(cudaVersion, hipVersion);
+  // The renames: the overlays override the tables, the last overlay entry for a CUDA name wins, and then
+  // the first table with the CUDA name wins; every table is already sorted, so each insert is a linear merge.
+  SortedMap<llvm::StringRef, ID> renamesMap;
+  std::vector<std::pair<llvm::StringRef, ID>> entries;
+  for (ID id = overlay.size(); id > 0; --id) {
+    entries.push_back({getCudaName(id - 1), id - 1});
+  }
+  renamesMap.insert(entries.begin(), entries.end());
+  for (auto &table : CUDA_RENAMES_TABLES()) {
+    entries.clear();
+    for (auto id : getIDs(table.map)) {
+      entries.push_back({getCudaName(id), id});
+    }
+    renamesMap.insert(entries.begin(), entries.end());
+  }
+  renames.reserve(renamesMap.size());
+  for (auto &ma : renamesMap) {
+    renames.push_back(ma.second);
+    renamesByType[getCounter(ma.second).type].push_back(ma.second);
+  }
+}
+
+void MappingsTable::add(const SortedMap<llvm::StringRef, hipCounter> &map,
+                        const SortedMap<llvm::StringRef, cudaAPIversions> &cudaVersionMap,
+                        llvm::ArrayRef<const SortedMap<llvm::StringRef, hipAPIversions>*> hipVersionMaps) {
+  const ID begin = size();
+  auto v = cudaVersionMap.begin();
+  for (auto &ma : map) {
+    cudaNames.push_back(ma.first);
+    counters.push_back(&ma.second);
+    // Both maps are sorted by CUDA names, so the CUDA versions are joined in a single pass.
+    while (v != cudaVersionMap.end() && v->first < ma.first) ++v;
+    cudaVersions.push_back(v != cudaVersionMap.end() && v->first == ma.first ? v->second : cudaAPIversions());
+    hipAPIversions hipVer;
+    for (auto hipVersionMap : hipVersionMaps) {
+      const auto found = hipVersionMap->find(ma.second.hipName);
+      if (found != hipVersionMap->end()) {
+        hipVer = found->second;
+        break;
+      }
+    }
+    hipVersions.push_back(hipVer);
+  }
+  mapRanges.push_back(std::make_pair(&map, std::make_pair(begin, ID(size()))));
+}
+
+void MappingsTable::add(llvm::ArrayRef<std::pair<llvm::StringRef, const hipCounter*>> overlay) {
+  for (auto &ma : overlay) {
+    cudaNames.push_back(ma.first);
+    counters.push_back(ma.second);
+    cudaVersions.push_back(cudaAPIversions());
+    hipVersions.push_back(hipAPIversions());
+  }
+}
+
+void MappingsTable::target(unsigned int cudaVersion, unsigned int hipVersion) {
+  if (!cudaVersion && !hipVersion) {
+    return;
+  }
+  for (ID id = 0; id < size(); ++id) {
+    unsigned int supportDegree = counters[id]->supportDegree;
+    const cudaAPIversions &cudaVer = cudaVersions[id];
+    const hipAPIversions &hipVer = hipVersions[id];
+    // Only the known versions are taken into account; the versions of cuDNN APIs are not CUDA versions.
+    if (cudaVersion) {
+      if (cudaVer.deprecated >= CUDA_10) {
+        supportDegree = cudaVer.deprecated <= cudaVersion ? supportDegree | CUDA_DEPRECATED : supportDegree & ~CUDA_DEPRECATED;
+      }
+      if (cudaVer.removed >= CUDA_10) {
+        supportDegree = cudaVer.removed <= cudaVersion ? supportDegree | CUDA_REMOVED : supportDegree & ~CUDA_REMOVED;
+      }
+    }
+    if (hipVersion) {
+      if (hipVer.appeared && hipVer.appeared > hipVersion) {
+        supportDegree |= HIP_UNSUPPORTED;
+      }
+      if (hipVer.removed && hipVer.removed <= hipVersion) {
+        supportDegree |= HIP_UNSUPPORTED | HIP_REMOVED;
+      }
+    }
+    if (supportDegree == counters[id]->supportDegree) {
+      continue;
+    }
+    targetedCounters.push_back(*counters[id]);
+    targetedCounters.back().supportDegree = supportDegree;
+    counters[id] = &targetedCounters.back();
+  }
+}
+
+llvm::ArrayRef<MappingsTable::ID> MappingsTable::getIDs(const SortedMap<llvm::StringRef, hipCounter> &map) const {
+  for (auto &range : mapRanges) {
+    if (range.first == &map) {
+      return llvm::makeArrayRef(ids).slice(range.second.first, range.second.second - range.second.first);
+    }
+  }
+  return llvm::ArrayRef<ID>();
+}
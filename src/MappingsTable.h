@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "CUDA2HIP.h"
+
+/**
+  * All the CUDA to HIP mappings in a single table stored by columns: a row per mapping of each of the maps
+  * (CUDA_RENAMES_TABLES, the overlays, CUDA_INCLUDE_MAP, CUDA_DEVICE_FUNC_MAP and CUDA_CUB_TYPE_NAME_MAP),
+  * identified by a dense ID. The CUDA and HIP versions are joined with the mappings once, when the table is
+  * built, so the generators of scripts and documentation don't look them up entry by entry.
+  *
+  * The table is built on the first use, which should be after loading the mapping overlays. With -cuda-version
+  * or -hip-version the counters of the mappings are targeted to those versions when the table is built: a mapping
+  * to a HIP API, which appeared after or was removed by the target HIP version, becomes HIP_UNSUPPORTED, and a CUDA
+  * API is DEPRECATED or REMOVED as of the target CUDA version.
+  */
+class MappingsTable {
+public:
+  typedef unsigned int ID;
+
+  static const MappingsTable &get();
+
+  size_t size() const { return cudaNames.size(); }
+  llvm::StringRef getCudaName(ID id) const { return cudaNames[id]; }
+  const hipCounter &getCounter(ID id) const { return *counters[id]; }
+  const cudaAPIversions &getCudaVersions(ID id) const { return cudaVersions[id]; }
+  const hipAPIversions &getHipVersions(ID id) const { return hipVersions[id]; }
+
+  // The mappings of the map, in the order of CUDA names; empty for a map, which is not in the table.
+  llvm::ArrayRef<ID> getIDs(const SortedMap<llvm::StringRef, hipCounter> &map) const;
+  // The mappings of CUDA_RENAMES_MAP, in the order of CUDA names.
+  llvm::ArrayRef<ID> getRenames() const { return renames; }
+  // The mappings of CUDA_RENAMES_MAP of the given type, in the order of CUDA names.
+  llvm::ArrayRef<ID> getRenames(ConvTypes type) const { return renamesByType[type]; }
+
+private:
+  std::vector<llvm::StringRef> cudaNames;
+  std::vector<const hipCounter*> counters;
+  std::vector<cudaAPIversions> cudaVersions;
+  std::vector<hipAPIversions> hipVersions;
+  // 0, 1, ..., size() - 1: the storage of the ID ranges of the maps.
+  std::vector<ID> ids;
+  std::vector<std::pair<const SortedMap<llvm::StringRef, hipCounter>*, std::pair<ID, ID>>> mapRanges;
+  std::vector<ID> renames;
+  std::vector<ID> renamesByType[NUM_CONV_TYPES];
+  // The counters of the mappings, changed by targeting the versions.
+  std::deque<hipCounter> targetedCounters;
+
+  MappingsTable();
+  void add(const SortedMap<llvm::StringRef, hipCounter> &map,
+           const SortedMap<llvm::StringRef, cudaAPIversions> &cudaVersionMap,
+           llvm::ArrayRef<const SortedMap<llvm::StringRef, hipAPIversions>*> hipVersionMaps);
+  void add(llvm::ArrayRef<std::pair<llvm::StringRef, const hipCounter*>> overlay);
+  void target(unsigned int cudaVersion, unsigned int hipVersion);
+};
@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#include "llvm/Support/ErrorHandling.h"
+
+/**
+  * An immutable-after-construction map, stored as a vector of pairs sorted by key.
+  *
+  * Used for the static CUDA to HIP mapping tables instead of std::map: the whole table is a single
+  * allocation, built by one sort at startup instead of node-by-node insertions, and is searched with
+  * a binary search. The semantics of std::map is kept: iteration is in key order, and for duplicate
+  * keys the first inserted value wins.
+  */
+template <typename K, typename V>
+class SortedMap {
+public:
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef std::pair<K, V> value_type;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+  typedef const_iterator iterator;
+  typedef typename std::vector<value_type>::const_reverse_iterator const_reverse_iterator;
+  typedef const_reverse_iterator reverse_iterator;
+  typedef typename std::vector<value_type>::size_type size_type;
+
+  SortedMap() {}
+  SortedMap(std::initializer_list<value_type> init): data(init) {
+    normalize(0);
+  }
+
+  const_iterator begin() const { return data.begin(); }
+  const_iterator end() const { return data.end(); }
+  const_reverse_iterator rbegin() const { return data.rbegin(); }
+  const_reverse_iterator rend() const { return data.rend(); }
+  size_type size() const { return data.size(); }
+  bool empty() const { return data.empty(); }
+
+  const_iterator find(const K &key) const {
+    const_iterator it = std::lower_bound(data.begin(), data.end(), key, lessKey);
+    return (it != data.end() && !(key < it->first)) ? it : data.end();
+  }
+
+  size_type count(const K &key) const {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  const V &at(const K &key) const {
+    const_iterator it = find(key);
+    if (it == end()) {
+      llvm::report_fatal_error("SortedMap::at: key is not found");
+    }
+    return it->second;
+  }
+
+  void reserve(size_type n) { data.reserve(n); }
+
+  // Insert the range [first, last); as with std::map::insert, the already present keys are not overwritten.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    size_type sorted = data.size();
+    data.insert(data.end(), first, last);
+    normalize(sorted);
+  }
+
+private:
+  std::vector<value_type> data;
+
+  static bool lessKey(const value_type &v, const K &key) { return v.first < key; }
+  static bool lessValue(const value_type &v1, const value_type &v2) { return v1.first < v2.first; }
+  static bool equalKeys(const value_type &v1, const value_type &v2) { return !(v1.first < v2.first) && !(v2.first < v1.first); }
+
+  // Sort the elements starting from the position `sorted` and merge them into the already sorted ones,
+  // keeping only the first of the elements with equal keys. Already sorted ranges are merged in linear time.
+  void normalize(size_type sorted) {
+    typename std::vector<value_type>::iterator middle = data.begin() + sorted;
+    if (!std::is_sorted(middle, data.end(), lessValue)) {
+      std::stable_sort(middle, data.end(), lessValue);
+    }
+    std::inplace_merge(data.begin(), middle, data.end(), lessValue);
+    data.erase(std::unique(data.begin(), data.end(), equalKeys), data.end());
+  }
+};
@@ -24,7 +24,15 @@ THE SOFTWARE.
 #include <assert.h>
 #include <sstream>
 #include <iomanip>
+#include <cstring>
+#include <algorithm>
+#include <ctime>
 #include "ArgParse.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Timer.h"
 
 const char *counterNames[NUM_CONV_TYPES] = {
   "error", // CONV_ERROR
@@ -159,8 +167,65 @@ void printStat(std::ostream *csv, llvm::raw_ostream *printOut, const std::string
     *csv << name << ";" << value << "\n";
 }
 
+// Quote and escape the string as a JSON string.
+std::string jsonString(const std::string &str) {
+  std::string quoted = "\"";
+  for (const char c : str) {
+    switch (c) {
+      case '"': quoted += "\\\""; break;
+      case '\\': quoted += "\\\\"; break;
+      case '\n': quoted += "\\n"; break;
+      case '\r': quoted += "\\r"; break;
+      case '\t': quoted += "\\t"; break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)c);
+          quoted += escaped;
+        } else {
+          quoted += c;
+        }
+    }
+  }
+  return quoted + "\"";
+}
+
+// Write the non-zero counters as a JSON object of the names and the counts.
+void printJSONCounts(std::ostream &out, const char *const names[], const int counts[], int size) {
+  out << "{";
+  bool first = true;
+  for (int i = 0; i < size; ++i) {
+    if (counts[i] > 0) {
+      out << (first ? "" : ",") << jsonString(names[i]) << ":" << counts[i];
+      first = false;
+    }
+  }
+  out << "}";
+}
+
 } // Anonymous namespace
 
+unsigned countNewLines(llvm::StringRef buffer) {
+  const uint64_t ones = 0x0101010101010101ULL;
+  const uint64_t low7bits = 0x7F7F7F7F7F7F7F7FULL;
+  const uint64_t newLines = ones * '\n';
+  const char *data = buffer.data();
+  size_t size = buffer.size(), i = 0;
+  unsigned count = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    // Zero bytes of x correspond to '\n' bytes of the word; set the high bit of exactly these bytes.
+    uint64_t x = word ^ newLines;
+    uint64_t zeros = ~(((x & low7bits) + low7bits) | x | low7bits);
+    count += llvm::countPopulation(zeros);
+  }
+  for (; i < size; ++i) {
+    if ('\n' == data[i]) ++count;
+  }
+  return count;
+}
+
 void StatCounter::incrementCounter(const hipCounter &counter, const std::string &name) {
   counters[name]++;
   apiCounters[(int) counter.apiType]++;
@@ -214,21 +279,34 @@ void StatCounter::print(std::ostream *csv, llvm::raw_ostream *printOut, const st
   }
 }
 
-Statistics::Statistics(const std::string &name): fileName(name) {
-  // Compute the total bytes/lines in the input file.
-  std::ifstream src_file(name, std::ios::binary | std::ios::ate);
-  if (src_file.good()) {
-    src_file.clear();
-    src_file.seekg(0);
-    totalLines = (unsigned)std::count(std::istreambuf_iterator<char>(src_file), std::istreambuf_iterator<char>(), '\n');
-    totalBytes = (int)src_file.tellg();
-    if (totalBytes < 0) {
-      totalBytes = 0;
-    }
+void StatCounter::printJSON(std::ostream &out) const {
+  out << "{\"by_type\":";
+  printJSONCounts(out, counterNames, convTypeCounters, NUM_CONV_TYPES);
+  out << ",\"by_api\":";
+  printJSONCounts(out, apiNames, apiCounters, NUM_API_TYPES);
+  out << ",\"by_name\":{";
+  bool first = true;
+  for (const auto &it : counters) {
+    out << (first ? "" : ",") << jsonString(it.first) << ":" << it.second;
+    first = false;
   }
+  out << "}}";
+}
+
+Statistics::Statistics(const std::string &name): fileName(name) {
   startTime = chr::steady_clock::now();
 }
 
+void Statistics::setSource(llvm::StringRef source) {
+  setSource(unsigned(source.size()), countNewLines(source));
+}
+
+void Statistics::setSource(unsigned bytes, unsigned lines) {
+  totalLines = lines;
+  totalBytes = (int)bytes;
+  touchedLinesBits.resize(totalLines + 2);
+}
+
 ///////// Counter update routines //////////
 
 void Statistics::incrementCounter(const hipCounter &counter, const std::string &name) {
@@ -246,26 +324,96 @@ void Statistics::add(const Statistics &other) {
   totalBytes += other.totalBytes;
   touchedLines += other.touchedLines;
   totalLines += other.totalLines;
+  for (const auto &p : other.matcherProfile) {
+    matcherProfile[p.first].matches += p.second.matches;
+    matcherProfile[p.first].seconds += p.second.seconds;
+  }
   if (other.hasErrors && !hasErrors) hasErrors = true;
   if (startTime > other.startTime)   startTime = other.startTime;
 }
 
+void Statistics::recordUsage(const hipCounter &counter, const std::string &name, unsigned line, unsigned column) {
+  usages.push_back({name, line, column, isUnsupported(counter)});
+}
+
 void Statistics::lineTouched(int lineNumber) {
-  touchedLinesSet.insert(lineNumber);
-  touchedLines = unsigned(touchedLinesSet.size());
+  if (lineNumber < 0) return;
+  unsigned line = unsigned(lineNumber);
+  if (line >= touchedLinesBits.size()) {
+    touchedLinesBits.resize(std::max(line + 1, 2 * touchedLinesBits.size()));
+  }
+  if (!touchedLinesBits.test(line)) {
+    touchedLinesBits.set(line);
+    ++touchedLines;
+  }
 }
 
 void Statistics::bytesChanged(int bytes) {
   touchedBytes += bytes;
 }
 
+void Statistics::matcherMatched(const std::string &matcher) {
+  matcherProfile[matcher].matches++;
+}
+
+void Statistics::matcherTimed(const std::string &matcher, double seconds) {
+  matcherProfile[matcher].seconds += seconds;
+}
+
 void Statistics::markCompletion() {
   completionTime = chr::steady_clock::now();
 }
 
+HeavyHitters::HeavyHitters(unsigned capacity): sketch(Depth * Width), capacity(capacity) {}
+
+void HeavyHitters::add(llvm::StringRef name, unsigned count) {
+  // The rows are indexed by double hashing; the update is conservative: only the counters below the new estimate
+  // are raised, which keeps the overestimation of the colliding names lower than incrementing all of them.
+  const uint64_t hash = llvm::hash_value(name);
+  const uint32_t h1 = uint32_t(hash), h2 = uint32_t(hash >> 32) | 1;
+  uint32_t *counters[Depth];
+  uint32_t estimate = UINT32_MAX;
+  for (unsigned i = 0; i < Depth; ++i) {
+    counters[i] = &sketch[i * Width + ((h1 + i * h2) & (Width - 1))];
+    estimate = std::min(estimate, *counters[i]);
+  }
+  estimate += count;
+  for (unsigned i = 0; i < Depth; ++i) {
+    *counters[i] = std::max(*counters[i], estimate);
+  }
+  auto it = candidates.find(name.str());
+  if (it != candidates.end()) {
+    candidatesByCount.erase(std::make_pair(it->second, it->first));
+    it->second = estimate;
+    candidatesByCount.insert(std::make_pair(estimate, it->first));
+    return;
+  }
+  if (candidates.size() >= capacity) {
+    if (estimate <= candidatesByCount.begin()->first) {
+      return;
+    }
+    candidates.erase(candidatesByCount.begin()->second);
+    candidatesByCount.erase(candidatesByCount.begin());
+  }
+  candidates.insert(std::make_pair(name.str(), estimate));
+  candidatesByCount.insert(std::make_pair(estimate, name.str()));
+}
+
+std::vector<std::pair<std::string, unsigned>> HeavyHitters::top(unsigned k) const {
+  std::vector<std::pair<std::string, unsigned>> ret;
+  for (auto it = candidatesByCount.rbegin(); it != candidatesByCount.rend() && ret.size() < k; ++it) {
+    ret.push_back(std::make_pair(it->second, it->first));
+  }
+  return ret;
+}
+
 ///////// Output functions //////////
 
 void Statistics::print(std::ostream *csv, llvm::raw_ostream *printOut, bool skipHeader) {
+  if (csv && isStatsFormatJSONL()) {
+    printJSONL(*csv, "file");
+    csv = nullptr;
+  }
   if (!skipHeader) {
     std::string str = "file \'" + fileName + "\' statistics:\n";
     conditionalPrint(csv, printOut, "\n" + str, "\n[HIPIFY] info: " + str);
@@ -294,30 +442,118 @@ void Statistics::print(std::ostream *csv, llvm::raw_ostream *printOut, bool skip
   printStat(csv, printOut, "TIME ELAPSED s", stream.str());
   supported.print(csv, printOut, "CONVERTED");
   unsupported.print(csv, printOut, "UNCONVERTED");
+  if (!matcherProfile.empty()) {
+    conditionalPrint(csv, printOut, "\nAST matcher;Matches;Time s\n", "[HIPIFY] info: AST matchers profile:\n");
+    for (const auto &p : matcherProfile) {
+      std::stringstream seconds;
+      seconds << std::fixed << std::setprecision(4) << p.second.seconds;
+      if (printOut)
+        *printOut << "  " << p.first << ": " << p.second.matches << " matches, " << seconds.str() << " s\n";
+      if (csv)
+        *csv << p.first << ";" << p.second.matches << ";" << seconds.str() << "\n";
+    }
+  }
+}
+
+void Statistics::printJSONL(std::ostream &out, const std::string &type, const std::string &extraFields) {
+  // The record is built in memory and written at once: a single write to the buffered stream and no flush per line.
+  std::ostringstream record;
+  int supportedSum = supported.getConvSum();
+  int unsupportedSum = unsupported.getConvSum();
+  int allSum = supportedSum + unsupportedSum;
+  typedef std::chrono::duration<double> duration;
+  duration elapsed = completionTime - startTime;
+  record << "{\"type\":" << jsonString(type) << ",\"file\":" << jsonString(fileName)
+         << ",\"errors\":" << (hasErrors || totalBytes <= 0 || totalLines <= 0 ? "true" : "false")
+         << ",\"converted\":" << supportedSum << ",\"unconverted\":" << unsupportedSum
+         << ",\"conversion_percent\":" << 100 - (0 == allSum ? 100 : std::lround(double(unsupportedSum * 100) / double(allSum)))
+         << ",\"replaced_bytes\":" << touchedBytes << ",\"total_bytes\":" << totalBytes
+         << ",\"changed_lines\":" << touchedLines << ",\"total_lines\":" << totalLines
+         << ",\"time_s\":" << std::fixed << std::setprecision(4) << elapsed.count()
+         << extraFields << ",\"converted_refs\":";
+  supported.printJSON(record);
+  record << ",\"unconverted_refs\":";
+  unsupported.printJSON(record);
+  if (!matcherProfile.empty()) {
+    record << ",\"matchers\":{";
+    bool first = true;
+    for (const auto &p : matcherProfile) {
+      record << (first ? "" : ",") << jsonString(p.first) << ":{\"matches\":" << p.second.matches
+             << ",\"time_s\":" << p.second.seconds << "}";
+      first = false;
+    }
+    record << "}";
+  }
+  record << "}\n";
+  out << record.str();
 }
 
 void Statistics::printAggregate(std::ostream *csv, llvm::raw_ostream *printOut) {
   Statistics globalStats = getAggregate();
-  // A file is considered "converted" if we made any changes to it.
-  int convertedFiles = 0;
+  unsigned convertedFiles = foldedConvertedFiles;
   for (const auto &p : stats) {
-    if (p.second.touchedLines && p.second.totalBytes &&
-        p.second.totalLines && !p.second.hasErrors) {
+    if (p.second.isConverted()) {
       convertedFiles++;
     }
   }
   globalStats.markCompletion();
+  if (csv && isStatsFormatJSONL()) {
+    std::ostringstream files;
+    files << ",\"converted_files\":" << convertedFiles << ",\"processed_files\":" << foldedFiles + stats.size();
+    globalStats.printJSONL(*csv, "aggregate", files.str());
+    csv = nullptr;
+  }
   globalStats.print(csv, printOut);
   std::string str = "TOTAL statistics:";
   conditionalPrint(csv, printOut, "\n" + str + "\n", "\n[HIPIFY] info: " + str + "\n");
   printStat(csv, printOut, "CONVERTED files", convertedFiles);
-  printStat(csv, printOut, "PROCESSED files", stats.size());
+  printStat(csv, printOut, "PROCESSED files", foldedFiles + stats.size());
+}
+
+void Statistics::printTopAPIs(std::ostream *csv, llvm::raw_ostream *printOut) {
+  const struct {
+    const HeavyHitters &hitters;
+    const char *title;
+    const char *jsonName;
+  } tops[] = {
+    {topRefs, "CUDA APIs by refs", "refs"},
+    {topUnsupportedRefs, "unsupported CUDA APIs by refs", "unsupported_refs"},
+    {topUnsupportedFiles, "unsupported CUDA APIs by files", "unsupported_files"},
+  };
+  // In JSON Lines, the tops are a single record instead of CSV sections.
+  std::ostream *jsonl = csv && isStatsFormatJSONL() ? csv : nullptr;
+  if (jsonl) {
+    csv = nullptr;
+  }
+  std::ostringstream record;
+  record << "{\"type\":\"top_apis\"";
+  for (const auto &t : tops) {
+    const std::vector<std::pair<std::string, unsigned>> top = t.hitters.top(PrintTopAPIs);
+    record << ",\"" << t.jsonName << "\":[";
+    for (size_t i = 0; i < top.size(); ++i) {
+      record << (i ? "," : "") << "{\"name\":" << jsonString(top[i].first) << ",\"count\":" << top[i].second << "}";
+    }
+    record << "]";
+    std::string str = "TOP " + std::to_string(unsigned(PrintTopAPIs)) + " " + t.title;
+    conditionalPrint(csv, printOut, "\n" + str + ";Count\n", "\n[HIPIFY] info: " + str + ":\n");
+    for (const auto &p : top) {
+      printStat(csv, printOut, p.first, p.second);
+    }
+  }
+  record << "}\n";
+  if (jsonl) {
+    *jsonl << record.str();
+  }
 }
 
 //// Static state management ////
 
+bool Statistics::isConverted() const {
+  return touchedLines && totalBytes && totalLines && !hasErrors;
+}
+
 Statistics Statistics::getAggregate() {
-  Statistics globalStats("GLOBAL");
+  Statistics globalStats = foldedFiles ? folded : Statistics("GLOBAL");
   for (const auto &p : stats) {
     globalStats.add(p.second);
   }
@@ -334,6 +570,68 @@ void Statistics::setActive(const std::string &name) {
   Statistics::currentStatistics = &stats.at(name);
 }
 
+void Statistics::setActive(Statistics *stat) {
+  Statistics::currentStatistics = stat;
+}
+
+void Statistics::fold(const std::string &name) {
+  auto it = stats.find(name);
+  if (it == stats.end()) return;
+  if (!foldedFiles) {
+    folded.startTime = it->second.startTime;
+    // Enough candidates for the top to be reliable even if it changes over the files.
+    const unsigned capacity = std::max(256u, 4 * unsigned(PrintTopAPIs));
+    topRefs.setCapacity(capacity);
+    topUnsupportedRefs.setCapacity(capacity);
+    topUnsupportedFiles.setCapacity(capacity);
+  }
+  folded.add(it->second);
+  foldedFiles++;
+  if (it->second.isConverted()) {
+    foldedConvertedFiles++;
+  }
+  if (isUsageIndexed()) {
+    usageIndex.add(name, it->second.usages);
+  }
+  if (PrintTopAPIs) {
+    for (const auto &p : it->second.supported.getCounters()) {
+      topRefs.add(p.first, p.second);
+    }
+    for (const auto &p : it->second.unsupported.getCounters()) {
+      topRefs.add(p.first, p.second);
+      topUnsupportedRefs.add(p.first, p.second);
+      topUnsupportedFiles.add(p.first);
+    }
+  }
+  if (currentStatistics == &it->second) {
+    currentStatistics = nullptr;
+  }
+  stats.erase(it);
+}
+
+bool Statistics::isUsageIndexed() {
+  return EmitUsageIndex;
+}
+
+bool Statistics::writeUsageIndex(llvm::StringRef path, std::string &error) {
+  return usageIndex.write(path, error);
+}
+
+Statistics &Statistics::addFile(Statistics &&stat) {
+  const std::string name = stat.fileName;
+  auto it = stats.find(name);
+  if (it == stats.end()) {
+    it = stats.emplace(std::make_pair(name, std::move(stat))).first;
+  } else {
+    it->second = std::move(stat);
+  }
+  return it->second;
+}
+
+bool Statistics::isStatsFormatJSONL() {
+  return OutputStatsFormat == "jsonl";
+}
+
 bool Statistics::isToRoc(const hipCounter &counter) {
   return TranslateToRoc && counter.apiType == API_BLAS;
 }
@@ -350,6 +648,10 @@ bool Statistics::isDeprecated(const hipCounter &counter) {
   return DEPRECATED == (counter.supportDegree & DEPRECATED);
 }
 
+bool Statistics::isRemoved(const hipCounter &counter) {
+  return REMOVED == (counter.supportDegree & REMOVED);
+}
+
 bool Statistics::isUnsupported(const hipCounter &counter) {
   if (UNSUPPORTED == (counter.supportDegree & UNSUPPORTED)) {
     return true;
@@ -472,5 +774,82 @@ std::string Statistics::getHipVersion(const hipVersions& ver) {
   return "";
 }
 
+bool Statistics::parseVersion(llvm::StringRef sVer, unsigned int &ver) {
+  ver = 0;
+  if (sVer.empty()) {
+    return true;
+  }
+  llvm::SmallVector<llvm::StringRef, 3> parts;
+  sVer.split(parts, '.');
+  unsigned int major = 0, minor = 0, patch = 0;
+  if (parts.size() > 3 || parts[0].getAsInteger(10, major) || major == 0 ||
+      (parts.size() > 1 && (parts[1].getAsInteger(10, minor) || minor >= 100)) ||
+      (parts.size() > 2 && (parts[2].getAsInteger(10, patch) || patch >= 10))) {
+    return false;
+  }
+  ver = major * 1000 + minor * 10 + patch;
+  return true;
+}
+
 std::map<std::string, Statistics> Statistics::stats = {};
-Statistics *Statistics::currentStatistics = nullptr;
+LLVM_THREAD_LOCAL Statistics *Statistics::currentStatistics = nullptr;
+Statistics Statistics::folded("GLOBAL");
+unsigned Statistics::foldedFiles = 0;
+unsigned Statistics::foldedConvertedFiles = 0;
+UsageIndexBuilder Statistics::usageIndex;
+HeavyHitters Statistics::topRefs;
+HeavyHitters Statistics::topUnsupportedRefs;
+HeavyHitters Statistics::topUnsupportedFiles;
+
+//// StartupProfile ////
+
+void StartupProfile::start() {
+  phases.clear();
+  lastTime = 0;
+  phase("static initialization");
+}
+
+void StartupProfile::phase(const std::string &name) {
+  double time = llvm::TimeRecord::getCurrentTime(false).getProcessTime();
+  phases.push_back(std::make_pair(name, time - lastTime));
+  lastTime = time;
+}
+
+bool StartupProfile::print(llvm::raw_ostream *printOut, const std::string &csvFileName) const {
+  if (printOut) {
+    *printOut << "[HIPIFY] info: startup profile:\n";
+    for (const auto &p : phases) {
+      std::stringstream seconds;
+      seconds << std::fixed << std::setprecision(4) << p.second;
+      *printOut << "  " << p.first << ": " << seconds.str() << " s\n";
+    }
+    std::stringstream seconds;
+    seconds << std::fixed << std::setprecision(4) << lastTime;
+    *printOut << "  TOTAL: " << seconds.str() << " s\n";
+  }
+  if (csvFileName.empty()) {
+    return true;
+  }
+  // A line per run is appended, so that the startup time is tracked across builds.
+  bool header = !llvm::sys::fs::exists(csvFileName);
+  std::ofstream csv(csvFileName, std::ios_base::app);
+  if (!csv) {
+    return false;
+  }
+  if (header) {
+    csv << "Date";
+    for (const auto &p : phases) {
+      csv << ";" << p.first << " s";
+    }
+    csv << ";TOTAL s\n";
+  }
+  char date[32] = {};
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+  csv << date << std::fixed << std::setprecision(4);
+  for (const auto &p : phases) {
+    csv << ";" << p.second;
+  }
+  csv << ";" << lastTime << "\n";
+  return bool(csv);
+}
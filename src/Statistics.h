@@ -27,8 +27,12 @@ THE SOFTWARE.
 #include <fstream>
 #include <map>
 #include <set>
+#include <vector>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/ADT/BitVector.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/Compiler.h>
+#include "UsageIndex.h"
 
 namespace chr = std::chrono;
 
@@ -278,6 +282,9 @@ extern const char *counterTypes[NUM_CONV_TYPES];
 extern const char *apiNames[NUM_API_TYPES];
 extern const char *apiTypes[NUM_API_TYPES];
 
+// Count '\n' in the buffer, processing 8 bytes at a time.
+unsigned countNewLines(llvm::StringRef buffer);
+
 struct hipCounter {
   llvm::StringRef hipName;
   llvm::StringRef rocName;
@@ -303,6 +310,44 @@ public:
   void add(const StatCounter &other);
   int getConvSum();
   void print(std::ostream* csv, llvm::raw_ostream* printOut, const std::string &prefix);
+  // Write the counters as a JSON object of the counts by type, by API and by name.
+  void printJSON(std::ostream &out) const;
+  const std::map<std::string, int> &getCounters() const { return counters; }
+};
+
+/**
+  * Approximate counts of the most frequent names in bounded memory, whatever the count of names: a count-min
+  * sketch estimates the count of any name, and only the names with the top estimates are kept, as candidates
+  * for the top. The estimates are never below the real counts, and are exact unless names collide in all the
+  * rows of the sketch.
+  */
+class HeavyHitters {
+public:
+  // Keep at most `capacity` candidates for the top.
+  explicit HeavyHitters(unsigned capacity = 256);
+  // Set the count of candidates before adding anything.
+  void setCapacity(unsigned c) { capacity = c; }
+  void add(llvm::StringRef name, unsigned count = 1);
+  // The top k names by estimated count, the most frequent first.
+  std::vector<std::pair<std::string, unsigned>> top(unsigned k) const;
+
+private:
+  static const unsigned Depth = 4;
+  static const unsigned Width = 4096;
+  // Depth rows of Width counters.
+  std::vector<uint32_t> sketch;
+  unsigned capacity;
+  // The candidates and their estimates; candidatesByCount is ordered by estimate for the eviction of the least one.
+  std::map<std::string, unsigned> candidates;
+  std::set<std::pair<unsigned, std::string>> candidatesByCount;
+};
+
+/**
+  * Cumulative time and matches count of a single AST matcher.
+  */
+struct MatcherProfile {
+  unsigned matches = 0;
+  double seconds = 0;
 };
 
 /**
@@ -311,22 +356,50 @@ public:
 class Statistics {
   StatCounter supported;
   StatCounter unsupported;
+  // AST matchers profile, filled only with -print-matcher-profile.
+  std::map<std::string, MatcherProfile> matcherProfile;
   std::string fileName;
-  std::set<int> touchedLinesSet = {};
+  // Bit N is set if line N has been touched.
+  llvm::BitVector touchedLinesBits;
   unsigned touchedLines = 0;
   unsigned totalLines = 0;
   unsigned touchedBytes = 0;
   int totalBytes = 0;
   chr::steady_clock::time_point startTime;
   chr::steady_clock::time_point completionTime;
+  // The aggregate of the folded Statistics, and the counts of all and of converted folded files.
+  static Statistics folded;
+  static unsigned foldedFiles;
+  static unsigned foldedConvertedFiles;
+  // The references of the folded files, collected only with -emit-usage-index.
+  static UsageIndexBuilder usageIndex;
+  // The most referenced CUDA names, and the most referenced and the most widespread unsupported ones, of the folded
+  // files: counted only with -print-top-apis.
+  static HeavyHitters topRefs;
+  static HeavyHitters topUnsupportedRefs;
+  static HeavyHitters topUnsupportedFiles;
+  // The references to CUDA names in the file, recorded only with -emit-usage-index.
+  std::vector<usageRecord> usages;
+  // A file is considered "converted" if we made any changes to it.
+  bool isConverted() const;
 
 public:
   Statistics(const std::string &name);
+  // Compute the total bytes/lines of the input file from its source buffer, already loaded by the SourceManager.
+  void setSource(llvm::StringRef source);
+  // Set the total bytes/lines of the input file, counted by the caller.
+  void setSource(unsigned bytes, unsigned lines);
   void incrementCounter(const hipCounter &counter, const std::string &name);
+  // Record the reference to the CUDA name at the line and column of the file for the usage index.
+  void recordUsage(const hipCounter &counter, const std::string &name, unsigned line, unsigned column);
   // Add the counters from `other` onto the counters of this object.
   void add(const Statistics &other);
   void lineTouched(int lineNumber);
   void bytesChanged(int bytes);
+  // Count a match of the named AST matcher.
+  void matcherMatched(const std::string &matcher);
+  // Add the time spent by the named AST matcher.
+  void matcherTimed(const std::string &matcher, double seconds);
   // Set the completion timestamp to now.
   void markCompletion();
 
@@ -339,18 +412,26 @@ public:
     *                 such stats are produced.
     */
   void print(std::ostream* csv, llvm::raw_ostream* printOut, bool skipHeader = false);
+  /**
+    * Write the statistics as a single line JSON record of the type ("file" or "aggregate") to out.
+    *
+    * @param extraFields The additional fields of the record, each starting with a comma.
+    */
+  void printJSONL(std::ostream &out, const std::string &type, const std::string &extraFields = "");
   // Print aggregated statistics for all registered counters.
   static void printAggregate(std::ostream *csv, llvm::raw_ostream* printOut);
+  // Print the top CUDA names by references, and the top unsupported ones by references and by files (-print-top-apis).
+  static void printTopAPIs(std::ostream *csv, llvm::raw_ostream* printOut);
   // The Statistics for each input file.
   static std::map<std::string, Statistics> stats;
-  // The Statistics objects for the currently-being-processed input file.
-  static Statistics* currentStatistics;
+  // The Statistics objects for the currently-being-processed input file of each thread.
+  static LLVM_THREAD_LOCAL Statistics* currentStatistics;
   // Aggregate statistics over all entries in `stats` and return the resulting Statistics object.
   static Statistics getAggregate();
   /**
-    * Convenient global entry point for updating the "active" Statistics. Since we operate single-threadedly
-    * processing one file at a time, this allows us to simply expose the stats for the current file globally,
-    * simplifying things.
+    * Convenient global entry point for updating the "active" Statistics. Each thread processes one file at a
+    * time, so this allows us to simply expose the stats for the current file of the thread globally, simplifying
+    * things.
     */
   static Statistics &current();
   /**
@@ -358,6 +439,27 @@ public:
     * timestamp into the currently active one.
     */
   static void setActive(const std::string &name);
+  /**
+    * Set the active Statistics object of the calling thread to `stat`, owned by the caller, or to none. A worker
+    * thread collects the statistics of its file so without locks; they are registered in `stats` by addFile.
+    */
+  static void setActive(Statistics *stat);
+  /**
+    * Move the Statistics of a file, collected by a worker thread, into `stats`, replacing the ones of the same
+    * file, and return them. Not thread-safe: `stats` is filled by a single thread.
+    */
+  static Statistics &addFile(Statistics &&stat);
+  /**
+    * Fold the Statistics of the file into the aggregate and free them, so that the memory doesn't grow with the
+    * count of files: once printed, they are needed only for the aggregate.
+    */
+  static void fold(const std::string &name);
+  // Check whether the references to CUDA names are recorded: option -emit-usage-index.
+  static bool isUsageIndexed();
+  // Write the usage index of the folded files; returns false and fills error in case of failure.
+  static bool writeUsageIndex(llvm::StringRef path, std::string &error);
+  // Check whether the statistics file is written in JSON Lines instead of CSV: option -o-stats-format=jsonl.
+  static bool isStatsFormatJSONL();
   // Check the counter and option TranslateToRoc whether it should be translated to Roc or not.
   static bool isToRoc(const hipCounter &counter);
   // Check whether the counter is HIP_UNSUPPORTED or not.
@@ -366,6 +468,8 @@ public:
   static bool isRocUnsupported(const hipCounter &counter);
   // Check whether the counter is DEPRECATED or not.
   static bool isDeprecated(const hipCounter& counter);
+  // Check whether the counter is REMOVED or not.
+  static bool isRemoved(const hipCounter& counter);
   /**
     * Check whether the counter is ROC_UNSUPPORTED/HIP_UNSUPPORTED/UNSUPPORTED or not
     * based on counter's API_TYPE and option TranslateToRoc.
@@ -375,6 +479,29 @@ public:
   static std::string getCudaVersion(const cudaVersions &ver);
   // Get string HIP version
   static std::string getHipVersion(const hipVersions &ver);
+  /**
+    * Parse string CUDA or HIP version "major[.minor[.patch]]" into the number of cudaVersions or hipVersions
+    * (major * 1000 + minor * 10 + patch); an empty string is parsed into 0.
+    */
+  static bool parseVersion(llvm::StringRef sVer, unsigned int &ver);
   // Set this flag in case of hipification errors
   bool hasErrors = false;
 };
+
+/**
+  * The time spent by hipify-clang from the process start till the first input file is ready to be hipified,
+  * by phases. The time is the process (user and system) time, so the phase before start() is the static
+  * initialization, including the one of the mapping tables.
+  */
+class StartupProfile {
+  std::vector<std::pair<std::string, double>> phases;
+  double lastTime = 0;
+
+public:
+  // Start recording: the time before this call is recorded as the static initialization.
+  void start();
+  // Record the time since the previous phase as the named phase.
+  void phase(const std::string &name);
+  // Print the phases to printOut, if not null, and append them as a line to the CSV file, if not empty.
+  bool print(llvm::raw_ostream *printOut, const std::string &csvFileName) const;
+};
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "UsageIndex.h"
+
+const char UsageIndex::Magic[8] = {'H', 'I', 'P', 'I', 'F', 'Y', 'U', 'X'};
+const char *const UsageIndex::FileName = "hipify-usage.idx";
+
+UsageIndex::UsageIndex(std::unique_ptr<llvm::MemoryBuffer> buffer): buffer(std::move(buffer)) {}
+
+std::unique_ptr<UsageIndex> UsageIndex::open(llvm::StringRef path, std::string &error) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    error = buffer.getError().message() + ": " + path.str();
+    return nullptr;
+  }
+  return create(std::move(buffer.get()), error);
+}
+
+std::unique_ptr<UsageIndex> UsageIndex::create(std::unique_ptr<llvm::MemoryBuffer> buffer, std::string &error) {
+  const char *start = buffer->getBufferStart();
+  const uint64_t size = buffer->getBufferSize();
+  if (size < sizeof(usageIndexHeader) || std::memcmp(start, Magic, sizeof(Magic)) != 0) {
+    error = "not a usage index: " + buffer->getBufferIdentifier().str();
+    return nullptr;
+  }
+  const usageIndexHeader *header = reinterpret_cast<const usageIndexHeader*>(start);
+  if (header->version != Version) {
+    error = "unsupported usage index version " + std::to_string(header->version) + ": " + buffer->getBufferIdentifier().str();
+    return nullptr;
+  }
+  const uint64_t filesEnd = uint64_t(header->filesOffset) + uint64_t(header->fileCount) * sizeof(usageIndexFile);
+  const uint64_t namesEnd = uint64_t(header->namesOffset) + uint64_t(header->nameCount) * sizeof(usageIndexName);
+  const uint64_t refsEnd = uint64_t(header->refsOffset) + uint64_t(header->refCount) * sizeof(usageIndexRef);
+  const uint64_t stringsEnd = uint64_t(header->stringsOffset) + header->stringsSize;
+  if (filesEnd > size || namesEnd > size || refsEnd > size || stringsEnd > size) {
+    error = "corrupted usage index: " + buffer->getBufferIdentifier().str();
+    return nullptr;
+  }
+  const usageIndexName *names = reinterpret_cast<const usageIndexName*>(start + header->namesOffset);
+  for (const usageIndexName *n = names; n != names + header->nameCount; ++n) {
+    if (uint64_t(n->firstRef) + n->refCount > header->refCount) {
+      error = "corrupted usage index: " + buffer->getBufferIdentifier().str();
+      return nullptr;
+    }
+  }
+  std::unique_ptr<UsageIndex> index(new UsageIndex(std::move(buffer)));
+  index->header = header;
+  index->files = reinterpret_cast<const usageIndexFile*>(start + header->filesOffset);
+  index->names = names;
+  index->refs = reinterpret_cast<const usageIndexRef*>(start + header->refsOffset);
+  index->strings = start + header->stringsOffset;
+  return index;
+}
+
+const usageIndexName *UsageIndex::find(llvm::StringRef name) const {
+  const usageIndexName *found = std::lower_bound(begin(), end(), name, [this](const usageIndexName &n, llvm::StringRef s) {
+    return getName(n) < s;
+  });
+  return found != end() && getName(*found) == name ? found : nullptr;
+}
+
+std::pair<const usageIndexName*, const usageIndexName*> UsageIndex::findPrefix(llvm::StringRef prefix) const {
+  const usageIndexName *first = std::lower_bound(begin(), end(), prefix, [this](const usageIndexName &n, llvm::StringRef s) {
+    return getName(n) < s;
+  });
+  const usageIndexName *last = first;
+  while (last != end() && getName(*last).startswith(prefix)) {
+    ++last;
+  }
+  return std::make_pair(first, last);
+}
+
+llvm::StringRef UsageIndex::getFileName(const usageIndexRef &r) const {
+  if (r.file >= fileCount()) {
+    return llvm::StringRef();
+  }
+  return getString(files[r.file].name, files[r.file].nameSize);
+}
+
+llvm::StringRef UsageIndex::getString(uint32_t offset, uint32_t size) const {
+  if (uint64_t(offset) + size > header->stringsSize) {
+    return llvm::StringRef();
+  }
+  return llvm::StringRef(strings + offset, size);
+}
+
+void UsageIndexBuilder::add(const std::string &fileName, std::vector<usageRecord> &records) {
+  const uint32_t file = uint32_t(files.size());
+  files.push_back(fileName);
+  for (const auto &r : records) {
+    auto it = nameIds.insert(std::make_pair(r.name, uint32_t(nameKeys.size())));
+    if (it.second) {
+      nameKeys.push_back(it.first->getKey());
+    }
+    refs.push_back({it.first->second, file, r.line, r.column, r.unsupported ? uint32_t(USAGE_UNSUPPORTED) : 0u});
+  }
+  std::vector<usageRecord>().swap(records);
+}
+
+bool UsageIndexBuilder::write(llvm::StringRef path, std::string &error) const {
+  // The names are sorted and the references are sorted by the rank of their name, then by file, line and column;
+  // the files are already in order.
+  std::vector<uint32_t> sortedNames(nameKeys.size());
+  for (uint32_t i = 0; i < sortedNames.size(); ++i) sortedNames[i] = i;
+  std::sort(sortedNames.begin(), sortedNames.end(), [this](uint32_t n1, uint32_t n2) {
+    return nameKeys[n1] < nameKeys[n2];
+  });
+  std::vector<uint32_t> rank(nameKeys.size());
+  for (uint32_t i = 0; i < sortedNames.size(); ++i) rank[sortedNames[i]] = i;
+  std::vector<ref> sortedRefs(refs);
+  std::sort(sortedRefs.begin(), sortedRefs.end(), [&rank](const ref &r1, const ref &r2) {
+    if (r1.name != r2.name) return rank[r1.name] < rank[r2.name];
+    if (r1.file != r2.file) return r1.file < r2.file;
+    return r1.line != r2.line ? r1.line < r2.line : r1.column < r2.column;
+  });
+  llvm::SmallString<65536> strings;
+  auto addString = [&strings](llvm::StringRef s) {
+    uint32_t offset = uint32_t(strings.size());
+    strings.append(s.begin(), s.end());
+    strings.push_back('\0');
+    return offset;
+  };
+  std::vector<usageIndexFile> fileEntries(files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    fileEntries[i].name = addString(files[i]);
+    fileEntries[i].nameSize = files[i].size();
+  }
+  std::vector<usageIndexName> nameEntries(sortedNames.size());
+  std::vector<usageIndexRef> refEntries(sortedRefs.size());
+  for (size_t i = 0, n = 0; n < nameEntries.size(); ++n) {
+    usageIndexName &e = nameEntries[n];
+    llvm::StringRef name = nameKeys[sortedNames[n]];
+    e.name = addString(name);
+    e.nameSize = name.size();
+    e.firstRef = i;
+    uint32_t unsupportedCount = 0;
+    for (; i < sortedRefs.size() && sortedRefs[i].name == sortedNames[n]; ++i) {
+      const ref &r = sortedRefs[i];
+      usageIndexRef &re = refEntries[i];
+      re.file = r.file;
+      re.line = r.line;
+      re.column = r.column;
+      re.flags = r.flags;
+      if (r.flags & USAGE_UNSUPPORTED) unsupportedCount++;
+    }
+    e.refCount = i - e.firstRef;
+    e.unsupportedCount = unsupportedCount;
+  }
+  usageIndexHeader header;
+  std::copy(UsageIndex::Magic, UsageIndex::Magic + sizeof(UsageIndex::Magic), header.magic);
+  header.version = UsageIndex::Version;
+  header.fileCount = fileEntries.size();
+  header.nameCount = nameEntries.size();
+  header.refCount = refEntries.size();
+  header.filesOffset = sizeof(usageIndexHeader);
+  header.namesOffset = header.filesOffset + fileEntries.size() * sizeof(usageIndexFile);
+  header.refsOffset = header.namesOffset + nameEntries.size() * sizeof(usageIndexName);
+  header.stringsOffset = header.refsOffset + refEntries.size() * sizeof(usageIndexRef);
+  header.stringsSize = strings.size();
+  std::ofstream out(path.str(), std::ios_base::trunc | std::ios_base::binary);
+  if (!out) {
+    error = "cannot open for writing: " + path.str();
+    return false;
+  }
+  // Each of the sections is written at once.
+  out.write(reinterpret_cast<const char*>(&header), sizeof(usageIndexHeader));
+  out.write(reinterpret_cast<const char*>(fileEntries.data()), fileEntries.size() * sizeof(usageIndexFile));
+  out.write(reinterpret_cast<const char*>(nameEntries.data()), nameEntries.size() * sizeof(usageIndexName));
+  out.write(reinterpret_cast<const char*>(refEntries.data()), refEntries.size() * sizeof(usageIndexRef));
+  out.write(strings.data(), strings.size());
+  out.close();
+  if (!out) {
+    error = "failed to write: " + path.str();
+    return false;
+  }
+  return true;
+}
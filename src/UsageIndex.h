@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+/**
+  * The binary CUDA API usage index, written by hipify-clang -emit-usage-index and queried by -query-usage.
+  *
+  * The index is memory-mapped and used in place, as the mappings database is: all the numbers are little-endian
+  * 32-bit integers, and all the strings are NUL-terminated. The layout is:
+  *
+  *   usageIndexHeader
+  *   usageIndexFile[fileCount]    the hipified source files
+  *   usageIndexName[nameCount]    the used CUDA names, sorted, each with its range of references
+  *   usageIndexRef[refCount]      the references, sorted by CUDA name, then by file, line and column
+  *   char[stringsSize]            string pool; the names of the files and of the CUDA names are offsets in it
+  *
+  * All the users of a CUDA name, or of all the names with a given prefix, are found by a binary search.
+  */
+
+typedef llvm::support::ulittle32_t uint32_le;
+
+enum usageRefFlags {
+  USAGE_UNSUPPORTED = 1
+};
+
+struct usageIndexHeader {
+  char magic[8];
+  uint32_le version;
+  uint32_le fileCount;
+  uint32_le nameCount;
+  uint32_le refCount;
+  uint32_le filesOffset;
+  uint32_le namesOffset;
+  uint32_le refsOffset;
+  uint32_le stringsOffset;
+  uint32_le stringsSize;
+};
+
+struct usageIndexFile {
+  uint32_le name;
+  uint32_le nameSize;
+};
+
+struct usageIndexName {
+  uint32_le name;
+  uint32_le nameSize;
+  uint32_le firstRef;
+  uint32_le refCount;
+  uint32_le unsupportedCount;
+};
+
+struct usageIndexRef {
+  uint32_le file;
+  uint32_le line;
+  uint32_le column;
+  uint32_le flags;
+};
+
+// A reference to a CUDA name in the file being hipified.
+struct usageRecord {
+  std::string name;
+  unsigned line;
+  unsigned column;
+  bool unsupported;
+};
+
+/**
+  * Read-only access to a loaded usage index.
+  */
+class UsageIndex {
+public:
+  static const char Magic[8];
+  // Incremented on every incompatible change of the layout.
+  static const uint32_t Version = 1;
+  // The default name of the index file.
+  static const char *const FileName;
+
+  // Load the index from the file; returns nullptr and fills error in case of failure.
+  static std::unique_ptr<UsageIndex> open(llvm::StringRef path, std::string &error);
+  // Use the already loaded index; returns nullptr and fills error if the buffer is not a valid index.
+  static std::unique_ptr<UsageIndex> create(std::unique_ptr<llvm::MemoryBuffer> buffer, std::string &error);
+
+  uint32_t fileCount() const { return header->fileCount; }
+  uint32_t nameCount() const { return header->nameCount; }
+  uint32_t refCount() const { return header->refCount; }
+  const usageIndexName *begin() const { return names; }
+  const usageIndexName *end() const { return names + nameCount(); }
+  // Returns nullptr if the CUDA name is not used.
+  const usageIndexName *find(llvm::StringRef name) const;
+  // Returns the range of the used CUDA names starting with the prefix.
+  std::pair<const usageIndexName*, const usageIndexName*> findPrefix(llvm::StringRef prefix) const;
+
+  llvm::StringRef getName(const usageIndexName &n) const { return getString(n.name, n.nameSize); }
+  const usageIndexRef *refsBegin(const usageIndexName &n) const { return refs + n.firstRef; }
+  const usageIndexRef *refsEnd(const usageIndexName &n) const { return refs + n.firstRef + n.refCount; }
+  llvm::StringRef getFileName(const usageIndexRef &r) const;
+
+private:
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  const usageIndexHeader *header = nullptr;
+  const usageIndexFile *files = nullptr;
+  const usageIndexName *names = nullptr;
+  const usageIndexRef *refs = nullptr;
+  const char *strings = nullptr;
+
+  explicit UsageIndex(std::unique_ptr<llvm::MemoryBuffer> buffer);
+  llvm::StringRef getString(uint32_t offset, uint32_t size) const;
+};
+
+/**
+  * Collects the references of all the hipified files, in the order of the files, and writes the index.
+  */
+class UsageIndexBuilder {
+public:
+  // Add the references of the file; the records are consumed.
+  void add(const std::string &fileName, std::vector<usageRecord> &records);
+  bool empty() const { return files.empty(); }
+  // Write the index to the file; returns false and fills error in case of failure.
+  bool write(llvm::StringRef path, std::string &error) const;
+
+private:
+  struct ref {
+    uint32_t name;
+    uint32_t file;
+    uint32_t line;
+    uint32_t column;
+    uint32_t flags;
+  };
+  // The CUDA names, interned: the value is the index of the name in nameKeys.
+  llvm::StringMap<uint32_t> nameIds;
+  std::vector<llvm::StringRef> nameKeys;
+  std::vector<std::string> files;
+  std::vector<ref> refs;
+};
@@ -31,8 +31,10 @@ THE SOFTWARE.
 #include "CUDA2HIP_Scripting.h"
 #include "LLVMCompat.h"
 #include "HipifyAction.h"
+#include "HipifyLex.h"
 #include "ArgParse.h"
 #include "StringUtils.h"
+#include "UsageIndex.h"
 #include "llvm/Support/Debug.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/DiagnosticIDs.h"
@@ -53,14 +55,20 @@ namespace ct = clang::tooling;
 void cleanupHipifyOptions(std::vector<const char*> &args) {
   std::vector<std::string> hipifyOptions = {"-perl", "-python", "-roc", "-inplace",
                                             "-no-backup", "-no-output", "-print-stats",
-                                            "-print-stats-csv", "-examine", "-save-temps",
-                                            "-skip-excluded-preprocessor-conditional-blocks"};
+                                            "-print-stats-csv", "-print-matcher-profile", "-print-startup-profile",
+                                            "-examine", "-save-temps",
+                                            "-skip-excluded-preprocessor-conditional-blocks",
+                                            "-skip-function-bodies-outside-main-file", "-use-ast-visitor",
+                                            "-check-mappings", "-mappings-db", "-lex", "-emit-usage-index"};
   for (const auto &a : hipifyOptions) {
     args.erase(std::remove(args.begin(), args.end(), a), args.end());
     args.erase(std::remove(args.begin(), args.end(), "-" + a), args.end());
   }
   std::vector<std::string> hipifyDirOptions = {"-o-dir", "-o-hipify-perl-dir", "-o-stats",
-                                               "-o-python-map-dir", "-temp-dir"};
+                                               "-o-python-map-dir", "-o-mappings-db-dir", "-temp-dir",
+                                               "-mapping-overlay", "-cuda-version", "-hip-version",
+                                               "-o-startup-profile", "-j", "-o-stats-format",
+                                               "-o-usage-index", "-query-usage", "-print-top-apis"};
   for (const auto &a : hipifyDirOptions) {
     // remove all pairs of arguments "-option value"
     auto it = args.erase(std::remove(args.begin(), args.end(), a), args.end());
@@ -175,7 +183,64 @@ bool generatePython() {
   return bToPython;
 }
 
+// Print the startup profile with -print-startup-profile and append it to the CSV file of -o-startup-profile.
+bool printStartupProfile(const StartupProfile &startupProfile) {
+  if (!startupProfile.print(PrintStartupProfile ? &llvm::errs() : nullptr, OutputStartupProfileFilename)) {
+    llvm::errs() << "\n" << sHipify << sError << "while writing startup profile to " << OutputStartupProfileFilename << "\n";
+    return false;
+  }
+  return true;
+}
+
+std::string getUsageIndexPath() {
+  std::string path = OutputUsageIndexFilename.empty() ? std::string(UsageIndex::FileName) : OutputUsageIndexFilename;
+  if (!OutputDir.empty() && !sys::path::is_absolute(path)) {
+    path = OutputDir + "/" + path;
+  }
+  return path;
+}
+
+// Print the references to the CUDA name or, if it ends with '*', to all the CUDA names with the prefix.
+bool queryUsage() {
+  std::string error;
+  const std::string path = getUsageIndexPath();
+  std::unique_ptr<UsageIndex> index = UsageIndex::open(path, error);
+  if (!index) {
+    llvm::errs() << "\n" << sHipify << sError << error << "\n";
+    return false;
+  }
+  StringRef query = QueryUsage;
+  std::pair<const usageIndexName*, const usageIndexName*> names;
+  if (query.endswith("*")) {
+    names = index->findPrefix(query.drop_back());
+  } else {
+    names.first = index->find(query);
+    names.second = names.first ? names.first + 1 : nullptr;
+  }
+  unsigned refs = 0;
+  for (const usageIndexName *n = names.first; n != names.second; ++n) {
+    for (const usageIndexRef *r = index->refsBegin(*n); r != index->refsEnd(*n); ++r) {
+      llvm::outs() << index->getFileName(*r) << ":" << r->line << ":" << r->column << ": " << index->getName(*n)
+                   << ((r->flags & USAGE_UNSUPPORTED) ? " (unsupported)" : "") << "\n";
+    }
+    refs += n->refCount;
+  }
+  llvm::errs() << sHipify << "info: " << refs << " references to " << QueryUsage << " in " << path << "\n";
+  return true;
+}
+
+bool emitUsageIndex() {
+  std::string error;
+  if (!Statistics::writeUsageIndex(getUsageIndexPath(), error)) {
+    llvm::errs() << "\n" << sHipify << sError << error << "\n";
+    return false;
+  }
+  return true;
+}
+
 int main(int argc, const char **argv) {
+  StartupProfile startupProfile;
+  startupProfile.start();
   std::vector<const char*> new_argv(argv, argv + argc);
   std::string sCompilationDatabaseDir;
   auto it = std::find(new_argv.begin(), new_argv.end(), std::string("-p"));
@@ -209,9 +274,11 @@ int main(int argc, const char **argv) {
   }
   llcompat::PrintStackTraceOnErrorSignal();
   ct::CommonOptionsParser OptionsParser(argc, argv, ToolTemplateCategory, llvm::cl::ZeroOrMore);
+  startupProfile.phase("options parsing");
   if (!llcompat::CheckCompatibility()) {
     return 1;
   }
+  startupProfile.phase("compatibility check");
   std::unique_ptr<ct::CompilationDatabase> compilationDatabase;
   std::vector<std::string> fileSources;
   if (bCompilationDatabase) {
@@ -225,7 +292,32 @@ int main(int argc, const char **argv) {
   } else {
     fileSources = OptionsParser.getSourcePathList();
   }
-  if (fileSources.empty() && !GeneratePerl && !GeneratePython && !GenerateMarkdown && !GenerateCSV) {
+  unsigned int ver = 0;
+  if (!Statistics::parseVersion(TargetCudaVersion, ver)) {
+    llvm::errs() << "\n" << sHipify << sError << "Wrong CUDA version: " << TargetCudaVersion << "\n";
+    return 1;
+  }
+  if (!Statistics::parseVersion(TargetHipVersion, ver)) {
+    llvm::errs() << "\n" << sHipify << sError << "Wrong HIP version: " << TargetHipVersion << "\n";
+    return 1;
+  }
+  if (OutputStatsFormat != "csv" && !Statistics::isStatsFormatJSONL()) {
+    llvm::errs() << "\n" << sHipify << sError << "Wrong statistics format: " << OutputStatsFormat << "\n";
+    return 1;
+  }
+  for (const auto &overlay : MappingOverlays) {
+    if (!loadMappingOverlay(overlay)) {
+      return 1;
+    }
+  }
+  if (CheckMappings && !checkRenames()) {
+    llvm::errs() << "\n" << sHipify << sError << "CUDA to HIP mappings check failed" << "\n";
+    return 1;
+  }
+  // Build the mappings now rather than on the first CUDA identifier, so that their time is a phase of its own.
+  CUDA_RENAMES_MAP();
+  startupProfile.phase("mapping tables");
+  if (fileSources.empty() && !GeneratePerl && !GeneratePython && !GenerateMappingsDB && !GenerateMarkdown && !GenerateCSV && !CheckMappings && QueryUsage.empty()) {
     llvm::errs() << "\n" << sHipify << sError << "Must specify at least 1 positional argument for source file" << "\n";
     return 1;
   }
@@ -237,10 +329,17 @@ int main(int argc, const char **argv) {
     llvm::errs() << "\n" << sHipify << sError << "hipify-python generating failed" << "\n";
     return 1;
   }
+  if (!mappingsdb::generate(GenerateMappingsDB)) {
+    llvm::errs() << "\n" << sHipify << sError << "Mappings database generating failed" << "\n";
+    return 1;
+  }
   if (!doc::generate(GenerateMarkdown, GenerateCSV)) {
     llvm::errs() << "\n" << sHipify << sError << "Documentation generating failed" << "\n";
     return 1;
   }
+  if (!QueryUsage.empty()) {
+    return queryUsage() ? 0 : 1;
+  }
   if (fileSources.empty()) {
     return 0;
   }
@@ -275,12 +374,22 @@ int main(int argc, const char **argv) {
     llvm::errs() << sHipify << sConflict << "both -o-dir and -inplace options are specified\n";
     return 1;
   }
+  if (PrintMatcherProfile && UseASTVisitor) {
+    llvm::errs() << sHipify << sConflict << "both -print-matcher-profile and -use-ast-visitor options are specified\n";
+    return 1;
+  }
   if (Examine) {
     NoOutput = PrintStats = true;
   }
+  if (PrintMatcherProfile && !PrintStatsCSV && OutputStatsFilename.empty()) {
+    PrintStats = true;
+  }
   int Result = 0;
   SmallString<128> tmpFile;
   StringRef sourceFileName, ext = "hip", csv_ext = "csv";
+  if (Statistics::isStatsFormatJSONL()) {
+    csv_ext = "jsonl";
+  }
   std::string sTmpFileName, sSourceAbsPath;
   std::string sTmpDirAbsParh = getAbsoluteDirectoryPath(TemporaryDir, EC);
   if (EC) {
@@ -295,7 +404,7 @@ int main(int argc, const char **argv) {
     create_csv = true;
   } else {
     if (PrintStatsCSV && fileSources.size() > 1) {
-      OutputStatsFilename = "sum_stat.csv";
+      OutputStatsFilename = "sum_stat." + csv_ext.str();
       create_csv = true;
     }
   }
@@ -308,7 +417,53 @@ int main(int argc, const char **argv) {
   if (PrintStats) {
     statPrint = &llvm::errs();
   }
+  if (Lex) {
+    // No clang invocation, no temporary files: each source is hipified right into its destination.
+    std::vector<std::string> destinations;
+    for (const auto &src : fileSources) {
+      std::string dstFile;
+      if (!NoOutput) {
+        if (!dst.empty()) {
+          dstFile = dst;
+        } else if (Inplace) {
+          dstFile = src;
+        } else if (!dstDir.empty()) {
+          dstFile = sOutputDirAbsPath + "/" + sys::path::filename(src).str() + "." + ext.str();
+        } else {
+          dstFile = src + "." + ext.str();
+        }
+      }
+      destinations.push_back(dstFile);
+    }
+    if (PrintStatsCSV && !csv) {
+      OutputStatsFilename = sys::path::filename(fileSources.front()).str() + "." + csv_ext.str();
+      if (!OutputDir.empty()) {
+        OutputStatsFilename = sOutputDirAbsPath + "/" + OutputStatsFilename;
+      }
+      csv = std::unique_ptr<std::ostream>(new std::ofstream(OutputStatsFilename, std::ios_base::trunc));
+    }
+    // No argument adjusters: the first source file is ready to be hipified right after its destination is set up.
+    startupProfile.phase("input files setup");
+    if ((PrintStartupProfile || !OutputStartupProfileFilename.empty()) && !printStartupProfile(startupProfile)) {
+      Result = 1;
+    }
+    if (!lex::hipify(fileSources, destinations, Jobs, csv.get(), statPrint)) {
+      Result = 1;
+    }
+    if (fileSources.size() > 1) {
+      Statistics::printAggregate(csv.get(), statPrint);
+    }
+    if (PrintTopAPIs) {
+      Statistics::printTopAPIs(csv.get(), &llvm::errs());
+    }
+    if (EmitUsageIndex && !emitUsageIndex()) {
+      Result = 1;
+    }
+    return Result;
+  }
   sortInputFiles(argc, argv, fileSources);
+  startupProfile.phase("input files setup");
+  bool bStartupProfiled = false;
   for (const auto &src : fileSources) {
     // Create a copy of the file to work on. When we're done, we'll move this onto the
     // output (which may mean overwriting the input, if we're in-place).
@@ -365,6 +520,13 @@ int main(int argc, const char **argv) {
     ct::Replacements &replacementsToUse = llcompat::getReplacements(Tool, tmpFile.c_str());
     ReplacementsFrontendActionFactory<HipifyAction> actionFactory(&replacementsToUse);
     appendArgumentsAdjusters(Tool, sSourceAbsPath, argv[0]);
+    if (!bStartupProfiled && (PrintStartupProfile || !OutputStartupProfileFilename.empty())) {
+      startupProfile.phase("argument adjusters");
+      if (!printStartupProfile(startupProfile)) {
+        Result = 1;
+      }
+    }
+    bStartupProfiled = true;
     Statistics &currentStat = Statistics::current();
     // Hipify _all_ the things!
     if (Tool.runAndSave(&actionFactory)) {
@@ -387,10 +549,17 @@ int main(int argc, const char **argv) {
     }
     Statistics::current().markCompletion();
     Statistics::current().print(csv.get(), statPrint);
+    Statistics::fold(src);
     dst.clear();
   }
   if (fileSources.size() > 1) {
     Statistics::printAggregate(csv.get(), statPrint);
   }
+  if (PrintTopAPIs) {
+    Statistics::printTopAPIs(csv.get(), &llvm::errs());
+  }
+  if (EmitUsageIndex && !emitUsageIndex()) {
+    Result = 1;
+  }
   return Result;
 }
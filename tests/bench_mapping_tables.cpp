@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// Measure the startup cost and the lookups of the CUDA to HIP mapping tables.
+//
+// Usage: bench-mapping-tables-bin [runs]
+//
+// The time and the number of allocations of the static initialization of the mapping tables are taken from
+// a marker, which is constructed before any other static object, till main. Then the same is taken for the first
+// CUDA_RENAMES_MAP() call, which merges the per-API tables. Then every CUDA name and a missing name per CUDA
+// name are looked up in a shuffled order, in CUDA_RENAMES_MAP() and in a std::map copy of it (the former tables);
+// the best time of the runs is printed for each; the numbers of the found names are checked to be the same.
+//
+// Run the benchmark on the builds of two revisions to compare their static initialization and merge.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include "ArgParse.h"
+#include "CUDA2HIP.h"
+
+using namespace llvm;
+
+// The globals of hipify-clang, which the mapping tables and Statistics use, with their hipify-clang values;
+// LLVMCompat.cpp and ArgParse.cpp are not linked in, as they need clang.
+extern const std::string sHipify = "[HIPIFY] ", sConflict = "conflict: ", sError = "error: ", sWarning = "warning: ";
+cl::opt<bool> TranslateToRoc("roc");
+cl::opt<std::string> OutputStatsFormat("o-stats-format", cl::init("csv"));
+cl::opt<bool> EmitUsageIndex("emit-usage-index");
+cl::opt<unsigned> PrintTopAPIs("print-top-apis", cl::init(0));
+cl::opt<std::string> TargetCudaVersion("cuda-version");
+cl::opt<std::string> TargetHipVersion("hip-version");
+
+namespace {
+
+typedef std::chrono::duration<double, std::milli> duration;
+
+size_t allocations = 0;
+
+// The start of the static initialization: the time and the number of allocations before it.
+struct Marker {
+  std::chrono::steady_clock::time_point time;
+  size_t allocations;
+  Marker(): time(std::chrono::steady_clock::now()), allocations(::allocations) {}
+};
+
+}
+
+// The marker is constructed before the static objects of the other files: the mapping tables.
+#if defined(_MSC_VER)
+#pragma init_seg(lib)
+#define INIT_FIRST
+#elif defined(__APPLE__)
+// No init_priority: this file is the first one in the link order.
+#define INIT_FIRST
+#else
+#define INIT_FIRST __attribute__((init_priority(101)))
+#endif
+static Marker start INIT_FIRST;
+
+void *operator new(size_t size) {
+  ++allocations;
+  void *p = std::malloc(size ? size : 1);
+  if (!p) std::abort();
+  return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+template <typename F>
+double bestOf(unsigned runs, F f) {
+  double best = 0;
+  for (unsigned i = 0; i < runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const double ms = duration(std::chrono::steady_clock::now() - start).count();
+    if (!i || ms < best) best = ms;
+  }
+  return best;
+}
+
+void report(const char *name, double ms, size_t allocs) {
+  outs() << format("  %-44s: %8.3f ms, %8zu allocations\n", name, ms, allocs);
+}
+
+void reportLookups(const char *name, double ms, size_t lookups) {
+  outs() << format("  %-44s: %8.3f ms, %8.1f ns/lookup\n", name, ms, ms * 1000000 / lookups);
+}
+
+}
+
+int main(int argc, const char **argv) {
+  const double initMs = duration(std::chrono::steady_clock::now() - start.time).count();
+  const size_t initAllocations = allocations - start.allocations;
+  const unsigned runs = argc > 1 ? unsigned(std::atoi(argv[1])) : 20;
+  if (!runs) {
+    errs() << "usage: " << argv[0] << " [runs]\n";
+    return 1;
+  }
+  auto begin = std::chrono::steady_clock::now();
+  size_t allocationsBefore = allocations;
+  const auto &renames = CUDA_RENAMES_MAP();
+  const double renamesMs = duration(std::chrono::steady_clock::now() - begin).count();
+  const size_t renamesAllocations = allocations - allocationsBefore;
+  outs() << "bench-mapping-tables: " << renames.size() << " CUDA names, " << runs << " runs\n";
+  report("static initialization", initMs, initAllocations);
+  report("first CUDA_RENAMES_MAP()", renamesMs, renamesAllocations);
+  typedef std::decay<decltype(renames)>::type Renames;
+  const std::map<StringRef, Renames::mapped_type> former(renames.begin(), renames.end());
+  std::vector<std::string> names;
+  names.reserve(renames.size() * 2);
+  for (const auto &r : renames) {
+    names.push_back(r.first.str());
+    names.push_back(r.first.str() + "_missing");
+  }
+  std::mt19937 random(1);
+  std::shuffle(names.begin(), names.end(), random);
+  const std::vector<StringRef> keys(names.begin(), names.end());
+  size_t sortedFound = 0, mapFound = 0;
+  reportLookups("lookups: CUDA_RENAMES_MAP()", bestOf(runs, [&] {
+    sortedFound = 0;
+    for (const StringRef &key : keys) sortedFound += renames.find(key) != renames.end();
+  }), keys.size());
+  reportLookups("lookups: std::map", bestOf(runs, [&] {
+    mapFound = 0;
+    for (const StringRef &key : keys) mapFound += former.find(key) != former.end();
+  }), keys.size());
+  if (sortedFound != renames.size() || mapFound != renames.size()) {
+    errs() << "error: names found differently: " << sortedFound << ", " << mapFound << " of " << renames.size() << "\n";
+    return 1;
+  }
+  return 0;
+}
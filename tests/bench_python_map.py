@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+# Measure the import time and memory of the hipify-python map generated by hipify-clang --python.
+#
+# Usage: bench_python_map.py <cuda_to_hip_mappings.py> [runs]
+#
+# The map is imported in fresh interpreters: first without its compiled .pyc (as on the first build), then with it
+# (as on every next build). If pyHIPIFY is not installed, a stub pyHIPIFY.constants is generated with all the
+# conversion and API types used by the map, each valued by its own name.
+import os
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+
+# The memory is traced in separate runs, as tracing slows the import down by an order of magnitude.
+IMPORT = """
+import sys, time, tracemalloc
+if sys.argv[1] == "memory":
+    tracemalloc.start()
+start = time.perf_counter()
+import cuda_to_hip_mappings
+elapsed = time.perf_counter() - start
+print(elapsed, tracemalloc.get_traced_memory()[1], len(cuda_to_hip_mappings.CUDA_RENAMES_MAP))
+"""
+
+
+def write_stub_constants(map_source, package_dir):
+    os.makedirs(package_dir)
+    with open(os.path.join(package_dir, "__init__.py"), "w"):
+        pass
+    names = sorted(set(re.findall(r"\b(?:CONV|API)_[A-Z0-9_]+\b", map_source)))
+    with open(os.path.join(package_dir, "constants.py"), "w") as constants:
+        for name in names + ["HIP_UNSUPPORTED"]:
+            constants.write("%s = %r\n" % (name, name))
+        constants.write("C10_MAPPINGS = {}\nPYTORCH_SPECIFIC_MAPPINGS = {}\n")
+
+
+def run_import(work_dir, mode="time"):
+    env = dict(os.environ, PYTHONPATH=work_dir)
+    env.pop("PYTHONDONTWRITEBYTECODE", None)
+    out = subprocess.check_output([sys.executable, "-c", IMPORT, mode], cwd=work_dir, env=env)
+    elapsed, peak, entries = out.split()
+    return float(elapsed), int(peak), int(entries)
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: %s <cuda_to_hip_mappings.py> [runs]" % sys.argv[0])
+    map_file = sys.argv[1]
+    runs = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+    with open(map_file) as f:
+        map_source = f.read()
+    work_dir = tempfile.mkdtemp(prefix="hipify-python-map-")
+    try:
+        shutil.copy(map_file, os.path.join(work_dir, "cuda_to_hip_mappings.py"))
+        try:
+            import pyHIPIFY.constants  # noqa: F401
+        except ImportError:
+            write_stub_constants(map_source, os.path.join(work_dir, "pyHIPIFY"))
+        cache_dir = os.path.join(work_dir, "__pycache__")
+        cold, warm = [], []
+        for _ in range(runs):
+            shutil.rmtree(cache_dir, ignore_errors=True)
+            cold.append(run_import(work_dir))
+            warm.append(run_import(work_dir))
+        _, peak, entries = run_import(work_dir, "memory")
+        print("%s: %d bytes, %d entries in CUDA_RENAMES_MAP, %d runs" % (map_file, len(map_source), entries, runs))
+        for name, results in (("without .pyc", cold), ("with .pyc", warm)):
+            times = [r[0] * 1000 for r in results]
+            print("  import %-12s: min %.1f ms, median %.1f ms" % (name, min(times), statistics.median(times)))
+        print("  peak memory allocated by the import: %.1f MB" % (peak / 1e6))
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2015 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// Measure the accounting of the source size and of the touched lines by Statistics against what it replaced.
+//
+// Usage: bench-statistics-bin [MB] [runs]
+//
+// A synthetic source of MB megabytes (16 by default) is written to a temporary file and loaded, as the
+// SourceManager loads it. Its lines are counted by re-reading the file with std::ifstream and std::count over
+// std::istreambuf_iterator (the former Statistics constructor), by std::count over the loaded buffer, and by
+// countNewLines. Then a replacement is reported on every third line, twice per line, in the order of the lines:
+// into a std::set<int> (the former Statistics::lineTouched) and into Statistics::lineTouched. The best time of
+// the runs is printed for each; the results are checked to be the same.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <set>
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "ArgParse.h"
+#include "Statistics.h"
+
+using namespace llvm;
+
+// The options, which Statistics reads, with their hipify-clang defaults.
+cl::opt<bool> TranslateToRoc("roc");
+cl::opt<std::string> OutputStatsFormat("o-stats-format", cl::init("csv"));
+cl::opt<bool> EmitUsageIndex("emit-usage-index");
+cl::opt<unsigned> PrintTopAPIs("print-top-apis", cl::init(0));
+
+namespace {
+
+typedef std::chrono::duration<double, std::milli> duration;
+
+template <typename F>
+double bestOf(unsigned runs, F f) {
+  double best = 0;
+  for (unsigned i = 0; i < runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const double ms = duration(std::chrono::steady_clock::now() - start).count();
+    if (!i || ms < best) best = ms;
+  }
+  return best;
+}
+
+void report(const char *name, double ms, double mb) {
+  outs() << format("  %-44s: %8.2f ms, %8.1f MB/s\n", name, ms, mb * 1000 / ms);
+}
+
+// The value of a count, as printed by Statistics::print.
+size_t printedCount(Statistics &stat, const std::string &name) {
+  std::string printed;
+  raw_string_ostream os(printed);
+  stat.print(nullptr, &os, true);
+  os.flush();
+  const size_t pos = printed.find(name + ": ");
+  return pos == std::string::npos ? 0 : size_t(std::atoll(printed.c_str() + pos + name.size() + 2));
+}
+
+std::string makeSource(size_t size) {
+  static const char *const lines[] = {
+    "#include <cuda_runtime.h>",
+    "",
+    "__global__ void axpy(float a, const float *x, float *y) {",
+    "  y[threadIdx.x] += a * x[threadIdx.x];",
+    "}",
+    "  cudaMalloc(&d_x, n * sizeof(float));",
+    "  cudaMemcpy(d_x, h_x, n * sizeof(float), cudaMemcpyHostToDevice);",
+    "  axpy<<<(n + 255) / 256, 256>>>(2.0f, d_x, d_y);",
+    "  // Check for the errors of the launch.",
+    "  cudaError_t err = cudaGetLastError();",
+  };
+  std::string source;
+  source.reserve(size + 128);
+  for (size_t i = 0; source.size() < size; ++i) {
+    source += lines[i % (sizeof(lines) / sizeof(lines[0]))];
+    source += '\n';
+  }
+  return source;
+}
+
+}
+
+int main(int argc, const char **argv) {
+  const double mb = argc > 1 ? std::atof(argv[1]) : 16;
+  const unsigned runs = argc > 2 ? unsigned(std::atoi(argv[2])) : 10;
+  if (mb <= 0 || !runs) {
+    errs() << "usage: " << argv[0] << " [MB] [runs]\n";
+    return 1;
+  }
+  SmallString<128> path;
+  if (std::error_code EC = sys::fs::createTemporaryFile("hipify-bench-statistics", "cu", path)) {
+    errs() << EC.message() << ": " << path << "\n";
+    return 1;
+  }
+  {
+    const std::string source = makeSource(size_t(mb * 1000000));
+    std::ofstream out(path.c_str(), std::ios_base::binary);
+    out << source;
+  }
+  ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFile(path);
+  if (!buffer) {
+    errs() << buffer.getError().message() << ": " << path << "\n";
+    sys::fs::remove(path);
+    return 1;
+  }
+  const StringRef source = buffer.get()->getBuffer();
+  outs() << "bench-statistics: " << source.size() << " bytes, " << runs << " runs\n";
+  unsigned streamLines = 0, countLines = 0, swarLines = 0;
+  report("lines: std::ifstream re-read, std::count", bestOf(runs, [&] {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    streamLines = unsigned(std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n'));
+  }), mb);
+  report("lines: std::count over the loaded buffer", bestOf(runs, [&] {
+    countLines = unsigned(std::count(source.begin(), source.end(), '\n'));
+  }), mb);
+  report("lines: countNewLines over the loaded buffer", bestOf(runs, [&] {
+    swarLines = countNewLines(source);
+  }), mb);
+  sys::fs::remove(path);
+  if (streamLines != countLines || swarLines != countLines) {
+    errs() << "error: lines counted differently: " << streamLines << ", " << countLines << ", " << swarLines << "\n";
+    return 1;
+  }
+  size_t setLines = 0;
+  std::unique_ptr<Statistics> stat;
+  report("touched lines: std::set<int>", bestOf(runs, [&] {
+    std::set<int> touched;
+    for (unsigned line = 1; line <= countLines; line += 3) {
+      touched.insert(int(line));
+      touched.insert(int(line));
+    }
+    setLines = touched.size();
+  }), mb);
+  report("touched lines: Statistics::lineTouched", bestOf(runs, [&] {
+    stat.reset(new Statistics("bench"));
+    stat->setSource(unsigned(source.size()), countLines);
+    for (unsigned line = 1; line <= countLines; line += 3) {
+      stat->lineTouched(int(line));
+      stat->lineTouched(int(line));
+    }
+  }), mb);
+  if (printedCount(*stat, "CHANGED lines of code") != setLines) {
+    errs() << "error: touched lines counted differently than " << setLines << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+# Run the hipification engines over the same corpus, diff their outputs and measure their throughput.
+#
+# Usage: diff_engines.py --hipify-clang <path> [options] [-- <clang args>]
+#
+# The engines are hipify-clang (clang mode), hipify-perl, freshly generated by hipify-clang --perl, and hipify-clang
+# -lex. The corpus is the sources under tests/unit_tests and a synthetic set of CUDA sources, generated into the work
+# directory. Each engine hipifies its own copy of the corpus in place, so that relative includes are resolved as in
+# the original tree: hipify-clang file by file, to tell the files it failed on, hipify-perl and -lex all at once.
+#
+# The outputs are diffed pairwise, and each differing hunk is counted in the rewrite category of its first CUDA or HIP
+# identifier, as hipify-clang --python maps it, or as a kernel launch, an include directive, extern shared memory,
+# host function arguments or a comment. The throughput of each engine is printed and appended to a CSV file.
+import argparse
+import datetime
+import difflib
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from bench_python_map import write_stub_constants  # noqa: E402
+
+ENGINES = ["clang", "perl", "lex"]
+SUFFIXES = (".cu", ".cuh", ".cpp", ".c", ".hpp", ".h")
+IDENTIFIER = re.compile(r"[A-Za-z_]\w*")
+
+SYNTHETIC_HEADER = """#include <cuda_runtime.h>
+#include <stdio.h>
+
+template <typename T, int N>
+__global__ void scale_{file}(T *data, T factor) {{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < N) data[i] = data[i] * factor;
+  __syncthreads();
+}}
+
+__global__ void fill_{file}(float *data, int n) {{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < n) data[i] = sqrtf(float(i));
+}}
+"""
+
+SYNTHETIC_FUNCTION = """
+// run_{file}_{func}: allocate with cudaMalloc, launch on a stream and time with cudaEvent_t
+int run_{file}_{func}(int n) {{
+  float *d = nullptr;
+  cudaStream_t stream;
+  cudaEvent_t start, stop;
+  cudaStreamCreate(&stream);
+  cudaEventCreate(&start);
+  cudaEventCreate(&stop);
+  cudaMalloc(&d, n * sizeof(float));
+  cudaMemsetAsync(d, 0, n * sizeof(float), stream);
+  cudaEventRecord(start, stream);
+  fill_{file}<<<(n + 255) / 256, 256, 0, stream>>>(d, n);
+  scale_{file}<float, 1024><<<dim3(4, 1), dim3(256), 0, stream>>>(d, 2.0f);
+  cudaEventRecord(stop, stream);
+  cudaEventSynchronize(stop);
+  float ms = 0;
+  cudaEventElapsedTime(&ms, start, stop);
+  cudaError_t err = cudaGetLastError();
+  if (err != cudaSuccess) printf("run_{file}_{func}: %s\\n", cudaGetErrorString(err));
+  cudaFree(d);
+  cudaEventDestroy(start);
+  cudaEventDestroy(stop);
+  cudaStreamDestroy(stream);
+  return err == cudaSuccess ? 0 : 1;
+}}
+"""
+
+
+def collect_corpus(tests_dir, work_dir, synthetic_files, synthetic_functions):
+    """Copy the unit tests and generate the synthetic sources into work_dir/corpus; return their relative paths."""
+    corpus_dir = os.path.join(work_dir, "corpus")
+    shutil.copytree(os.path.join(tests_dir, "unit_tests"), os.path.join(corpus_dir, "unit_tests"))
+    os.makedirs(os.path.join(corpus_dir, "synthetic"))
+    for i in range(synthetic_files):
+        with open(os.path.join(corpus_dir, "synthetic", "synthetic_%d.cu" % i), "w") as f:
+            f.write(SYNTHETIC_HEADER.format(file=i))
+            for j in range(synthetic_functions):
+                f.write(SYNTHETIC_FUNCTION.format(file=i, func=j))
+    files = []
+    for root, _, names in os.walk(corpus_dir):
+        for name in sorted(names):
+            if name.endswith(SUFFIXES):
+                files.append(os.path.relpath(os.path.join(root, name), corpus_dir))
+    return corpus_dir, sorted(files)
+
+
+def run(command, log, cwd):
+    """Run the command, appending its output to the log; return its exit code and wall time."""
+    start = time.perf_counter()
+    code = subprocess.call(command, stdout=log, stderr=subprocess.STDOUT, cwd=cwd)
+    return code, time.perf_counter() - start
+
+
+def hipify(engine, args, corpus_dir, files, work_dir):
+    """Hipify a copy of the corpus in place with the engine; return its directory, time and the files it failed on."""
+    engine_dir = os.path.join(work_dir, engine)
+    shutil.copytree(corpus_dir, engine_dir)
+    paths = [os.path.join(engine_dir, f) for f in files]
+    failed = []
+    with open(os.path.join(work_dir, engine + ".log"), "w") as log:
+        if engine == "clang":
+            elapsed = 0
+            for f, path in zip(files, paths):
+                code, seconds = run([args.hipify_clang, "-inplace", path] + args.hipify_args + ["--"] + args.clang_args,
+                                    log, engine_dir)
+                elapsed += seconds
+                if code:
+                    failed.append(f)
+        else:
+            if engine == "perl":
+                command = ["perl", os.path.join(work_dir, "hipify-perl"), "-inplace", "-quiet-warnings",
+                           "-j", str(args.jobs)]
+            else:
+                command = [args.hipify_clang, "-lex", "-inplace", "-j", str(args.jobs)]
+            code, elapsed = run(command + paths, log, engine_dir)
+            if code:
+                failed = list(files)
+    return engine_dir, elapsed, failed
+
+
+def load_categories(args, work_dir):
+    """Map the CUDA and HIP names to their rewrite categories by the map, which hipify-clang --python generates."""
+    subprocess.check_call([args.hipify_clang, "--python", "-o-python-map-dir=" + work_dir])
+    map_file = os.path.join(work_dir, "cuda_to_hip_mappings.py")
+    with open(map_file) as f:
+        write_stub_constants(f.read(), os.path.join(work_dir, "pyHIPIFY"))
+    sys.path.insert(0, work_dir)
+    import cuda_to_hip_mappings
+    categories = {}
+    for cuda_name, value in cuda_to_hip_mappings.CUDA_RENAMES_MAP.items():
+        category = value[1][len("CONV_"):].lower()
+        categories.setdefault(cuda_name, category)
+        if value[0]:
+            categories.setdefault(value[0], category)
+    return categories
+
+
+def strip_comment(line):
+    return line.split("//", 1)[0].rstrip()
+
+
+def categorize(old, new, categories):
+    """The rewrite category of a hunk, whose lines are old in one output and new in the other."""
+    old, new = [strip_comment(l) for l in old], [strip_comment(l) for l in new]
+    if old == new:
+        return "comment"
+    text = "\n".join(old + new)
+    if "hipLaunchKernelGGL" in text or "<<<" in text:
+        return "kernel_launch"
+    if "HIP_DYNAMIC_SHARED" in text or "extern __shared__" in text:
+        return "extern_shared"
+    if "HIP_SYMBOL" in text or "reinterpret_cast<const void*>" in text:
+        return "host_function_args"
+    if any(line.lstrip().startswith("#") and "include" in line for line in old + new):
+        return "include"
+    old_names = set(IDENTIFIER.findall("\n".join(old)))
+    new_names = set(IDENTIFIER.findall("\n".join(new)))
+    for name in sorted(old_names ^ new_names):
+        if name in categories:
+            return categories[name]
+    return "other"
+
+
+def diff_outputs(left_dir, right_dir, files, categories):
+    """Count the differing hunks by category and list the differing files."""
+    counts, differing = {}, []
+    for f in files:
+        with open(os.path.join(left_dir, f), errors="replace") as left, \
+             open(os.path.join(right_dir, f), errors="replace") as right:
+            left_lines, right_lines = left.read().splitlines(), right.read().splitlines()
+        if left_lines == right_lines:
+            continue
+        differing.append(f)
+        matcher = difflib.SequenceMatcher(None, left_lines, right_lines, autojunk=False)
+        for tag, i1, i2, j1, j2 in matcher.get_opcodes():
+            if tag != "equal":
+                category = categorize(left_lines[i1:i2], right_lines[j1:j2], categories)
+                counts[category] = counts.get(category, 0) + 1
+    return counts, differing
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Diff and measure hipify-clang, hipify-perl and hipify-clang -lex.")
+    parser.add_argument("--hipify-clang", required=True, help="hipify-clang executable")
+    parser.add_argument("--hipify-arg", dest="hipify_args", action="append", default=[],
+                        help="hipify-clang argument for clang mode, e.g. --cuda-path=<dir>")
+    parser.add_argument("--work-dir", default="hipify-engines", help="directory for the corpus copies and logs")
+    parser.add_argument("--synthetic-files", type=int, default=32, help="count of synthetic sources")
+    parser.add_argument("--synthetic-functions", type=int, default=64, help="count of host functions per synthetic source")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="parallel jobs of hipify-perl and -lex")
+    parser.add_argument("--engines", default=",".join(ENGINES), help="comma-separated engines to run")
+    parser.add_argument("--csv", default="hipify-engines.csv", help="CSV file to append the throughput to")
+    parser.add_argument("--verbose", action="store_true", help="list the differing files")
+    parser.add_argument("clang_args", nargs="*", help="clang arguments after --")
+    args = parser.parse_args()
+    engines = [e for e in args.engines.split(",") if e]
+    for e in engines:
+        if e not in ENGINES:
+            parser.error("unknown engine: " + e)
+    tests_dir = os.path.dirname(os.path.abspath(__file__))
+    work_dir = os.path.abspath(args.work_dir)
+    shutil.rmtree(work_dir, ignore_errors=True)
+    os.makedirs(work_dir)
+    if "perl" in engines:
+        subprocess.check_call([args.hipify_clang, "--perl", "-o-hipify-perl-dir=" + work_dir])
+    categories = load_categories(args, work_dir)
+    corpus_dir, files = collect_corpus(tests_dir, work_dir, args.synthetic_files, args.synthetic_functions)
+    total_bytes = sum(os.path.getsize(os.path.join(corpus_dir, f)) for f in files)
+
+    results = {}
+    print("%-6s %7s %9s %9s %9s %9s %7s" % ("engine", "files", "MB", "seconds", "files/s", "MB/s", "failed"))
+    now = datetime.datetime.now().isoformat(timespec="seconds")
+    with open(args.csv, "a") as csv:
+        for engine in engines:
+            engine_dir, elapsed, failed = hipify(engine, args, corpus_dir, files, work_dir)
+            results[engine] = (engine_dir, set(failed))
+            elapsed = max(elapsed, 1e-9)
+            mb = total_bytes / 1e6
+            print("%-6s %7d %9.2f %9.2f %9.1f %9.2f %7d" %
+                  (engine, len(files), mb, elapsed, len(files) / elapsed, mb / elapsed, len(failed)))
+            csv.write("%s;%s;%d;%d;%.3f;%.1f;%.2f;%d\n" %
+                      (now, engine, len(files), total_bytes, elapsed, len(files) / elapsed, mb / elapsed, len(failed)))
+
+    pairs = [(a, b) for i, a in enumerate(engines) for b in engines[i + 1:]]
+    mismatches = {}
+    for a, b in pairs:
+        compared = [f for f in files if f not in results[a][1] and f not in results[b][1]]
+        mismatches[(a, b)] = diff_outputs(results[a][0], results[b][0], compared, categories) + (len(compared),)
+    if not pairs:
+        return 0
+    print("\nDiffering hunks by rewrite category:")
+    all_categories = sorted(set(c for counts, _, _ in mismatches.values() for c in counts))
+    header = ["%s-%s" % pair for pair in pairs]
+    print("%-20s " % "category" + " ".join("%12s" % h for h in header))
+    for category in all_categories:
+        print("%-20s " % category + " ".join("%12d" % mismatches[pair][0].get(category, 0) for pair in pairs))
+    print("%-20s " % "differing files" +
+          " ".join("%12s" % ("%d/%d" % (len(mismatches[pair][1]), mismatches[pair][2])) for pair in pairs))
+    if args.verbose:
+        for pair in pairs:
+            for f in mismatches[pair][1]:
+                print("%s-%s: %s" % (pair[0], pair[1], f))
+    # The engines are expected to differ; failing to run one of them at all is the error.
+    return 1 if any(len(failed) == len(files) for _, failed in results.values()) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,4 +1,5 @@
 // RUN: %run_test hipify "%s" "%t" %hipify_args %clang_args "-Xclang" "-fcuda-allow-variadic-functions"
+// RUN: %run_test hipify "%s" "%t" %hipify_args "-use-ast-visitor" %clang_args "-Xclang" "-fcuda-allow-variadic-functions"
 
 /*
 Copyright (c) 2015-present Advanced Micro Devices, Inc. All rights reserved.
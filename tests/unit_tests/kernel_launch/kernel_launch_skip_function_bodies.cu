@@ -0,0 +1,52 @@
+// RUN: %run_test hipify "%s" "%t" %hipify_args "-skip-function-bodies-outside-main-file" %clang_args
+// Kernel launches and device symbols should be hipified in the same way, when function bodies from included headers are skipped.
+
+// CHECK: #include <hip/hip_runtime.h>
+#include <cuda_runtime.h>
+#include <algorithm>
+
+#define NUM 1024
+#define SIZE NUM * sizeof(int)
+
+#define CUDA_LAUNCH(cuda_call,dimGrid,dimBlock, ...) \
+    cuda_call<<<dimGrid,dimBlock>>>(__VA_ARGS__);
+
+__device__ int globalIn[NUM];
+__device__ int globalOut[NUM];
+
+__global__ void Assign(int *Out) {
+  int tid = threadIdx.x + blockIdx.x * blockDim.x;
+  Out[tid] = globalIn[tid];
+  globalOut[tid] = std::max(globalIn[tid], 0);
+}
+
+template <typename T>
+__global__ void Fill(T *Out, T value) {
+  Out[threadIdx.x + blockIdx.x * blockDim.x] = value;
+}
+
+int main() {
+  int *A, *Ad;
+  A = new int[NUM];
+  for (int i = 0; i < NUM; ++i) {
+    A[i] = i;
+  }
+  // CHECK: hipMalloc((void**)&Ad, SIZE);
+  cudaMalloc((void**)&Ad, SIZE);
+  // CHECK: hipMemcpyToSymbol(HIP_SYMBOL(globalIn), A, SIZE, 0, hipMemcpyHostToDevice);
+  cudaMemcpyToSymbol(globalIn, A, SIZE, 0, cudaMemcpyHostToDevice);
+  // CHECK: hipLaunchKernelGGL(Assign, dim3(1, 1, 1), dim3(NUM, 1, 1), 0, 0, Ad);
+  Assign<<<dim3(1, 1, 1), dim3(NUM, 1, 1)>>>(Ad);
+  dim3 dimGrid(NUM / 512, 1, 1);
+  dim3 dimBlock(512, 1, 1);
+  // CHECK: hipLaunchKernelGGL(Assign, dim3(dimGrid), dim3(dimBlock), 0, 0, Ad);
+  CUDA_LAUNCH(Assign, dimGrid, dimBlock, Ad);
+  // CHECK: hipLaunchKernelGGL(HIP_KERNEL_NAME(Fill<int>), dim3(dimGrid), dim3(dimBlock), 0, 0, Ad, 0);
+  Fill<int><<<dimGrid, dimBlock>>>(Ad, 0);
+  // CHECK: hipMemcpyFromSymbol(A, HIP_SYMBOL(globalOut), SIZE, 0, hipMemcpyDeviceToHost);
+  cudaMemcpyFromSymbol(A, globalOut, SIZE, 0, cudaMemcpyDeviceToHost);
+  // CHECK: hipFree(Ad);
+  cudaFree(Ad);
+  delete [] A;
+  return 0;
+}
@@ -0,0 +1,31 @@
+// RUN: hipify -lex -no-output "%s" 2>&1 | FileCheck "%s"
+
+// The CUDA names in the launch configurations are hipified before the launches themselves are reported,
+// so the lines and columns of the matches after them are still counted from the launches on.
+// CHECK: launch_config_lines.cu:17:20: warning: CUDA identifier is unsupported in HIP.
+// CHECK-NEXT: launch_config_lines.cu:26:3: warning: CUDA identifier is unsupported in HIP.
+// CHECK-NEXT: launch_config_lines.cu:27:20: warning: CUDA identifier is unsupported in HIP.
+// CHECK-NEXT: launch_config_lines.cu:29:5: warning: CUDA identifier is unsupported in HIP.
+// CHECK-NOT: warning
+#include <cuda_runtime.h>
+
+__global__ void fill(float *x, float v) {
+  x[threadIdx.x] = v;
+}
+
+void run(float *d, cudaArray_t dst, cudaArray_t src, void *s) {
+  fill<<<1, 32, 0, cudaStreamPerThread>>>(d, 1.0f);
+  fill<<<1, 32, 0, (cudaStream_t)s>>>(d, 2.0f);
+  fill<<<dim3(1), dim3(32), 0, (cudaStream_t)s>>>(
+    d, 3.0f);
+  cudaStream_t stream;
+  cudaStreamCreate(&stream);
+  fill<<<1, 32, 0, stream>>>(d, 4.0f);
+  cudaStreamSynchronize(stream);
+  cudaStreamDestroy(stream);
+  cudaMemcpy2DArrayToArray(dst, 0, 0, src, 0, 0, 16, 16, cudaMemcpyDefault);
+  fill<<<1, 32, 0, cudaStreamPerThread>>>(d, 5.0f);
+  {
+    cudaMemcpy2DArrayToArray(dst, 0, 0, src, 0, 0, 16, 16, cudaMemcpyDefault);
+  }
+}
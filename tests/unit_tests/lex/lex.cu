@@ -0,0 +1,38 @@
+// RUN: %run_test hipify "%s" "%t" %hipify_args "-lex" %clang_args
+
+// CHECK: #include "hip/hip_runtime.h"
+// CHECK: #include <hiprand.h>
+#include <curand.h>
+#include <stdio.h>
+
+template <typename T, int N>
+__global__ void axpy(T a, const T *x, T *y) {
+  y[threadIdx.x] += a * x[threadIdx.x] * N;
+}
+
+__global__ void empty() {}
+
+int main() {
+  float *x = nullptr, *y = nullptr;
+  // CHECK: hipStream_t stream;
+  cudaStream_t stream;
+  // CHECK: hipStreamCreate(&stream);
+  cudaStreamCreate(&stream);
+  // CHECK: hipMalloc(&x, sizeof(float) * 4);
+  cudaMalloc(&x, sizeof(float) * 4);
+  // CHECK: hipMalloc(&y, sizeof(float) * 4);
+  cudaMalloc(&y, sizeof(float) * 4);
+  // CHECK: hipLaunchKernelGGL(HIP_KERNEL_NAME(axpy<float, 4>), dim3(1), dim3(4), 0, stream, 2.0f, x, y);
+  axpy<float, 4><<<1, 4, 0, stream>>>(2.0f, x, y);
+  // CHECK: hipLaunchKernelGGL(empty, dim3(dim3(1, 1)), dim3(1), 0, 0);
+  empty<<<dim3(1, 1), 1>>>();
+  // CHECK: printf("hipMemcpy: %s\n", hipGetErrorString(hipGetLastError()));
+  printf("cudaMemcpy: %s\n", cudaGetErrorString(cudaGetLastError()));
+  // CHECK: hipStreamDestroy(stream);
+  cudaStreamDestroy(stream);
+  // CHECK: hipFree(x);
+  cudaFree(x);
+  // CHECK: hipFree(y);
+  cudaFree(y);
+  return 0;
+}
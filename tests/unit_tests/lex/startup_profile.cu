@@ -0,0 +1,16 @@
+// RUN: hipify -lex -no-output -print-startup-profile "%s" 2>&1 | FileCheck "%s"
+
+// The startup profile is printed with -lex as well, right before the first file is hipified; there is no argument
+// adjusters phase.
+// CHECK: [HIPIFY] info: startup profile:
+// CHECK-NEXT: static initialization: {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s
+// CHECK-NEXT: options parsing: {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s
+// CHECK-NEXT: compatibility check: {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s
+// CHECK-NEXT: mapping tables: {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s
+// CHECK-NEXT: input files setup: {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s
+// CHECK-NEXT: TOTAL: {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s
+#include <cuda_runtime.h>
+
+void alloc(void **p) {
+  cudaMalloc(p, 256);
+}
@@ -0,0 +1,18 @@
+// RUN: hipify -lex -no-output -o-stats-format=jsonl -o-stats=%t.jsonl "%S/stats_jsonl_copy.cu" "%s"
+// RUN: FileCheck --input-file=%t.jsonl "%s"
+
+// A JSON record per file, in the order of the sources; stats_jsonl_copy.cu is the code below without the comments.
+// CHECK: {"type":"file","file":"{{.*}}stats_jsonl_copy.cu","errors":false,"converted":8,"unconverted":1,"conversion_percent":89,"replaced_bytes":103,"total_bytes":287,"changed_lines":6,"total_lines":9,"time_s":{{[0-9.]+}},"converted_refs":{"by_type":{"memory":3,"include_cuda_main_header":1,"type":2,"numeric_literal":2},"by_api":{"CUDA RT API":8},"by_name":{"cudaArray_t":2,"cudaFree":1,"cudaMalloc":1,"cudaMemcpy":1,"cudaMemcpyDefault":1,"cudaMemcpyHostToDevice":1,"cuda_runtime.h":1}},"unconverted_refs":{"by_type":{"memory":1},"by_api":{"CUDA RT API":1},"by_name":{"cudaMemcpy2DArrayToArray":1}}}
+// CHECK-NEXT: {"type":"file","file":"{{.*}}stats_jsonl.cu","errors":false,"converted":8,"unconverted":1,
+// And one record for all the files.
+// CHECK-NEXT: {"type":"aggregate","file":"GLOBAL","errors":false,"converted":16,"unconverted":2,"conversion_percent":89,"replaced_bytes":206,{{.*}},"changed_lines":12,{{.*}},"converted_files":2,"processed_files":2,"converted_refs":{"by_type":{"memory":6,"include_cuda_main_header":2,"type":4,"numeric_literal":4},"by_api":{"CUDA RT API":16},"by_name":{"cudaArray_t":4,"cudaFree":2,"cudaMalloc":2,"cudaMemcpy":2,"cudaMemcpyDefault":2,"cudaMemcpyHostToDevice":2,"cuda_runtime.h":2}},"unconverted_refs":{"by_type":{"memory":2},"by_api":{"CUDA RT API":2},"by_name":{"cudaMemcpy2DArrayToArray":2}}}
+// CHECK-NOT: {"type"
+#include <cuda_runtime.h>
+
+void copy(float *h, cudaArray_t dst, cudaArray_t src) {
+  float *d = nullptr;
+  cudaMalloc(&d, 256 * sizeof(float));
+  cudaMemcpy(d, h, 256, cudaMemcpyHostToDevice);
+  cudaFree(d);
+  cudaMemcpy2DArrayToArray(dst, 0, 0, src, 0, 0, 16, 16, cudaMemcpyDefault);
+}
@@ -0,0 +1,9 @@
+#include <cuda_runtime.h>
+
+void copy(float *h, cudaArray_t dst, cudaArray_t src) {
+  float *d = nullptr;
+  cudaMalloc(&d, 256 * sizeof(float));
+  cudaMemcpy(d, h, 256, cudaMemcpyHostToDevice);
+  cudaFree(d);
+  cudaMemcpy2DArrayToArray(dst, 0, 0, src, 0, 0, 16, 16, cudaMemcpyDefault);
+}
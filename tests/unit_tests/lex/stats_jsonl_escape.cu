@@ -0,0 +1,15 @@
+// REQUIRES: shell
+// RUN: rm -rf %t && mkdir %t
+// RUN: bash -c 'cp "$0" "$1/stats_jsonl_escape.cu" && cp "$0" "$1/$(printf "ctl\001")_stats.cu"' %s %t
+// RUN: hipify -lex -no-output -o-dir=%t -o-stats-format=jsonl %t/stats_jsonl_escape.cu && not ls %t/stats_jsonl_escape.cu.jsonl
+// RUN: hipify -lex -no-output -o-stats-format=jsonl -o-stats=%t/stats.jsonl %t/*_stats.cu
+// RUN: FileCheck --input-file=%t/stats.jsonl %s
+
+// -o-stats-format alone writes no statistics file.
+// The control character in the file name is escaped.
+// CHECK: {"type":"file","file":"{{.*}}/ctl\u0001_stats.cu","errors":false,"converted":2,
+#include <cuda_runtime.h>
+
+void alloc(float **d) {
+  cudaMalloc(d, 256 * sizeof(float));
+}
@@ -0,0 +1,38 @@
+// RUN: hipify -lex -no-output -print-top-apis=4 "%s" "%S/top_apis_shutdown.cu" 2>&1 | FileCheck "%s"
+
+// The references of both files, the most frequent first, with their exact counts.
+// CHECK: [HIPIFY] info: TOP 4 CUDA APIs by refs:
+// CHECK-NEXT: cudaMalloc: 5
+// CHECK-NEXT: cudaFree: 4
+// CHECK-NEXT: cudaMemcpy2DArrayToArray: 3
+// CHECK-NEXT: cublasShutdown: 2
+// CHECK-EMPTY:
+// CHECK-NEXT: [HIPIFY] info: TOP 4 unsupported CUDA APIs by refs:
+// CHECK-NEXT: cudaMemcpy2DArrayToArray: 3
+// CHECK-NEXT: cublasShutdown: 2
+// CHECK-EMPTY:
+// By files, cublasShutdown referenced in both files comes first.
+// CHECK-NEXT: [HIPIFY] info: TOP 4 unsupported CUDA APIs by files:
+// CHECK-NEXT: cublasShutdown: 2
+// CHECK-NEXT: cudaMemcpy2DArrayToArray: 1
+// CHECK-NOT: {{.}}
+
+void alloc(float **a, float **b, float **c, float **d, float **e) {
+  cudaMalloc(a, 16);
+  cudaMalloc(b, 16);
+  cudaMalloc(c, 16);
+  cudaMalloc(d, 16);
+  cudaMalloc(e, 16);
+  cudaFree(*a);
+  cudaFree(*b);
+  cudaFree(*c);
+  cudaFree(*d);
+}
+
+void copy() {
+  cudaMemcpy2DArrayToArray(0, 0, 0, 0, 0, 0, 16, 16, 0);
+  cudaMemcpy2DArrayToArray(0, 0, 0, 0, 0, 0, 32, 32, 0);
+  cudaMemcpy2DArrayToArray(0, 0, 0, 0, 0, 0, 64, 64, 0);
+  cudaDeviceSynchronize();
+  cublasShutdown();
+}
@@ -0,0 +1,6 @@
+void reset() {
+  cudaDeviceReset();
+  cudaDeviceReset();
+  cudaDeviceReset();
+  cudaDeviceReset();
+}
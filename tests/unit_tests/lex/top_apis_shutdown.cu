@@ -0,0 +1,3 @@
+void shutdown() {
+  cublasShutdown();
+}
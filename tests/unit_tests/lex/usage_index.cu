@@ -0,0 +1,29 @@
+// RUN: hipify -lex -no-output -emit-usage-index -o-usage-index="%t.idx" "%s" && hipify -query-usage="cudaMemcpy*" -o-usage-index="%t.idx" | FileCheck "%s"
+
+// The references are sorted by the CUDA name, then by the line and column.
+// CHECK: usage_index.cu:22:3: cudaMemcpy{{$}}
+// CHECK-NEXT: usage_index.cu:25:3: cudaMemcpy{{$}}
+// CHECK-NEXT: usage_index.cu:28:3: cudaMemcpy2DArrayToArray (unsupported)
+// CHECK-NEXT: usage_index.cu:23:3: cudaMemcpyAsync{{$}}
+// CHECK-NEXT: usage_index.cu:28:58: cudaMemcpyDefault{{$}}
+// CHECK-NEXT: usage_index.cu:25:25: cudaMemcpyDeviceToHost{{$}}
+// CHECK-NEXT: usage_index.cu:22:25: cudaMemcpyHostToDevice{{$}}
+// CHECK-NEXT: usage_index.cu:23:30: cudaMemcpyHostToDevice{{$}}
+// CHECK-NOT: cudaMalloc
+#include <cuda_runtime.h>
+
+__global__ void scale(float *x, float a) {
+  x[threadIdx.x] *= a;
+}
+
+void run(float *h, cudaArray_t dst, cudaArray_t src, cudaStream_t stream) {
+  float *d = nullptr;
+  cudaMalloc(&d, 256 * sizeof(float));
+  cudaMemcpy(d, h, 256, cudaMemcpyHostToDevice);
+  cudaMemcpyAsync(d, h, 256, cudaMemcpyHostToDevice, stream);
+  scale<<<1, 256>>>(d, 2.0f);
+  cudaMemcpy(h, d, 256, cudaMemcpyDeviceToHost);
+  cudaFree(d);
+  // cudaMemcpy in a comment is not a reference.
+  cudaMemcpy2DArrayToArray(dst, 0, 0, src, 0, 0, 16, 16, cudaMemcpyDefault);
+}
@@ -0,0 +1,20 @@
+// RUN: %run_test hipify "%s" "%t" %hipify_args "-hip-version=3.7.0" %clang_args
+// CUDA APIs, mapped to HIP APIs which appeared after the target HIP version, should be left as is.
+
+// CHECK: #include <hip/hip_runtime.h>
+#include <cuda_runtime.h>
+
+int main() {
+  int value = 0;
+  // CHECK: cudaDeviceP2PAttr attr = cudaDevP2PAttrPerformanceRank;
+  cudaDeviceP2PAttr attr = cudaDevP2PAttrPerformanceRank;
+  // CHECK: hipStream_t stream;
+  cudaStream_t stream;
+  // CHECK: hipStreamCreate(&stream);
+  cudaStreamCreate(&stream);
+  // CHECK: hipDeviceGetP2PAttribute(&value, attr, 0, 1);
+  cudaDeviceGetP2PAttribute(&value, attr, 0, 1);
+  // CHECK: hipStreamDestroy(stream);
+  cudaStreamDestroy(stream);
+  return 0;
+}
@@ -0,0 +1,36 @@
+// RUN: %run_test hipify "%s" "%t" %hipify_args "-mapping-overlay=%S/mapping_overlay.txt" %clang_args
+// User mappings from the overlay should be applied along with, and instead of, the built-in ones.
+
+// CHECK: #include <hip/hip_runtime.h>
+#include <cuda_runtime.h>
+
+// CHECK: typedef hipStream_t myHipStream_t;
+typedef cudaStream_t myCudaStream_t;
+
+// CHECK: hipError_t myHipMalloc(void **ptr, size_t size);
+cudaError_t myCudaMalloc(void **ptr, size_t size);
+// CHECK: hipError_t myHipFree(void *ptr);
+cudaError_t myCudaFree(void *ptr);
+
+__global__ void Inc(int *Out) {
+  Out[threadIdx.x] += 1;
+}
+
+int main() {
+  int *Ad = nullptr;
+  // CHECK: myHipStream_t stream;
+  myCudaStream_t stream;
+  // CHECK: hipStreamCreate(&stream);
+  cudaStreamCreate(&stream);
+  // CHECK: myHipMalloc((void**)&Ad, 64 * sizeof(int));
+  myCudaMalloc((void**)&Ad, 64 * sizeof(int));
+  // CHECK: hipLaunchKernelGGL(Inc, dim3(1), dim3(64), 0, stream, Ad);
+  Inc<<<1, 64, 0, stream>>>(Ad);
+  // CHECK: myHipDeviceSynchronize();
+  cudaDeviceSynchronize();
+  // CHECK: myHipFree(Ad);
+  myCudaFree(Ad);
+  // CHECK: hipStreamDestroy(stream);
+  cudaStreamDestroy(stream);
+  return 0;
+}
@@ -0,0 +1,35 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: hipify -mappings-db -o-mappings-db-dir=%t
+// RUN: hipify -lex -mapping-overlay=%t/hipify-mappings.db -o=%t/db.hip "%s"
+// RUN: FileCheck --input-file=%t/db.hip "%s"
+
+// Every CUDA to HIP rename read back from the generated mappings database overrides the built-in one:
+// the sources should be hipified exactly as with the built-in mappings. The checks are anchored at the line starts,
+// so that they do not match themselves in the hipified comments.
+
+// CHECK: {{^}}#include <hip/hip_runtime.h>
+#include <cuda_runtime.h>
+// CHECK: {{^}}#include "hipblas.h"
+#include "cublas_v2.h"
+
+void run(float *h, float *x, float *y, int n) {
+  // CHECK: {{^}}  hipStream_t stream;
+  cudaStream_t stream;
+  // CHECK: {{^}}  hipStreamCreateWithFlags(&stream, hipStreamNonBlocking);
+  cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+  // CHECK: {{^}}  hipMemcpyAsync(x, h, n * sizeof(float), hipMemcpyHostToDevice, stream);
+  cudaMemcpyAsync(x, h, n * sizeof(float), cudaMemcpyHostToDevice, stream);
+  // CHECK: {{^}}  hipblasHandle_t handle;
+  cublasHandle_t handle;
+  // CHECK: {{^}}  hipblasCreate(&handle);
+  cublasCreate(&handle);
+  const float alpha = 2.0f;
+  // CHECK: {{^}}  hipblasSaxpy(handle, n, &alpha, x, 1, y, 1);
+  cublasSaxpy(handle, n, &alpha, x, 1, y, 1);
+  // CHECK: {{^}}  cublasShutdown();
+  cublasShutdown();
+  // CHECK: {{^}}  hipDevice_t device;
+  CUdevice device;
+  // CHECK: {{^}}  hipDeviceGet(&device, 0);
+  cuDeviceGet(&device, 0);
+}
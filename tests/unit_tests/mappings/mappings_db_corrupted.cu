@@ -0,0 +1,12 @@
+// REQUIRES: shell
+// RUN: not hipify -mapping-overlay=%S/mappings_db_corrupted_kind.db 2>&1 | FileCheck "%s"
+// RUN: not hipify -mapping-overlay=%S/mappings_db_corrupted_type.db 2>&1 | FileCheck "%s"
+// RUN: not hipify -mapping-overlay=%S/mappings_db_corrupted_api_type.db 2>&1 | FileCheck "%s"
+// RUN: not hipify -mapping-overlay=%S/mappings_db_corrupted_name.db 2>&1 | FileCheck "%s"
+// RUN: not hipify -mapping-overlay=%S/mappings_db_corrupted_empty_name.db 2>&1 | FileCheck "%s"
+
+// Each database has a single cudaMalloc entry with one corrupted field: the kind, the type, the API type, the offset
+// of the CUDA name out of the string pool, or the empty CUDA name. It is rejected as a whole on loading, before any
+// source file is needed.
+// CHECK: [HIPIFY] error: corrupted mappings database: {{.*}}mappings_db_corrupted_{{[a-z_]+}}.db
+// CHECK-NOT: Must specify
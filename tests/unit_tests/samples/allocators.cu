@@ -1,4 +1,5 @@
 // RUN: %run_test hipify "%s" "%t" %hipify_args %clang_args
+// RUN: %run_test hipify "%s" "%t" %hipify_args "-use-ast-visitor" %clang_args
 
 #pragma once
 // CHECK: #include <hip/hip_runtime.h>
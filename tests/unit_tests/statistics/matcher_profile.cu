@@ -0,0 +1,28 @@
+// RUN: hipify -no-output -print-matcher-profile "%s" %hipify_args -- %clang_args 2>&1 | FileCheck "%s"
+
+// The profile follows the file statistics: a row per AST matcher, ordered by the matcher name, with its matches
+// count and its cumulative time.
+// CHECK: [HIPIFY] info: file '{{.*}}matcher_profile.cu' statistics:
+// CHECK: [HIPIFY] info: AST matchers profile:
+// CHECK: {{^}}  cudaHostFuncCall: 1 matches, {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s{{$}}
+// CHECK: {{^}}  cudaLaunchKernel: 2 matches, {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s{{$}}
+// CHECK: {{^}}  cudaSharedIncompleteArrayVar: 1 matches, {{[0-9]+\.[0-9][0-9][0-9][0-9]}} s{{$}}
+
+#include <cuda_runtime.h>
+
+__device__ int scale;
+
+__global__ void reverse(int *d, int n) {
+  extern __shared__ int s[];
+  int t = threadIdx.x;
+  s[t] = d[t] * scale;
+  __syncthreads();
+  d[t] = s[n - t - 1];
+}
+
+void run(int *d_d, int n) {
+  int h_scale = 2;
+  cudaMemcpyToSymbol(scale, &h_scale, sizeof(int));
+  reverse<<<1, n, n * sizeof(int)>>>(d_d, n);
+  reverse<<<1, n, n * sizeof(int)>>>(d_d, n);
+}